@@ -330,9 +330,15 @@ void    ImGuiTestContext::Sleep(float time)
     if (IsError())
         return;
 
+    // In fast mode, advance the virtual clock instead of waiting: the whole duration elapses in a single frame.
+    // (one frame is yielded first so inputs queued before calling Sleep() are applied before time passes, e.g. mouse held for 'time' seconds)
     if (EngineIO->ConfigRunSpeed == ImGuiTestRunSpeed_Fast)
     {
-        //ImGuiTestEngine_AddExtraTime(Engine, time); // We could add time, for now we have no use for it...
+        if (time > 0.0f)
+        {
+            ImGuiTestEngine_Yield(Engine);
+            ImGuiTestEngine_AddExtraTime(Engine, time);
+        }
         ImGuiTestEngine_Yield(Engine);
     }
     else
@@ -428,6 +434,8 @@ void ImGuiTestContext::SetRef(ImGuiWindow* window)
     size_t len = strlen(window->Name);
     IM_ASSERT(len < IM_ARRAYSIZE(RefStr) - 1);
     strcpy(RefStr, window->Name);
+    if (RefID != window->ID)
+        RefCacheClear();
     RefID = window->ID;
 
     MouseSetViewport(window);
@@ -449,11 +457,16 @@ void ImGuiTestContext::SetRef(ImGuiTestRef ref)
         IM_ASSERT(len < IM_ARRAYSIZE(RefStr) - 1);
 
         strcpy(RefStr, ref.Path);
-        RefID = GetID(ref.Path, ImGuiTestRef());
+        ImGuiID ref_id = GetID(ref.Path, ImGuiTestRef());
+        if (RefID != ref_id)
+            RefCacheClear();
+        RefID = ref_id;
     }
     else
     {
         RefStr[0] = 0;
+        if (RefID != ref.ID)
+            RefCacheClear();
         RefID = ref.ID;
     }
 
@@ -479,6 +492,64 @@ ImGuiWindow* ImGuiTestContext::GetWindowByRef(ImGuiTestRef ref)
     return window;
 }
 
+// Lookup a path relative to RefID in the cache. Return NULL if not found or if the last known item window has been destroyed.
+static ImGuiTestRefCacheEntry* ImGuiTestContext_RefCacheFind(ImGuiTestContext* ctx, const char* path)
+{
+    const ImGuiID key = ImHashStr(path, 0, ctx->RefID);
+    const int idx = ctx->RefCacheMap.GetInt(key, 0) - 1;
+    if (idx < 0)
+        return NULL;
+    ImGuiTestRefCacheEntry* entry = &ctx->RefCache[idx];
+    if (entry->Key != key || strcmp(ctx->RefCachePaths.begin() + entry->PathOffset, path) != 0)
+        return NULL;
+    if (entry->WindowID != 0 && ImGui::FindWindowByID(entry->WindowID) == NULL)
+    {
+        entry->Key = 0; // Dropped entries stay in RefCacheMap so RefCacheAdd() can reuse them
+        return NULL;
+    }
+    return entry;
+}
+
+static ImGuiTestRefCacheEntry* ImGuiTestContext_RefCacheAdd(ImGuiTestContext* ctx, const char* path, ImGuiID id)
+{
+    const ImGuiID key = ImHashStr(path, 0, ctx->RefID);
+    int idx = ctx->RefCacheMap.GetInt(key, 0) - 1;
+    const bool is_new = (idx < 0);
+    if (is_new)
+    {
+        idx = ctx->RefCache.Size;
+        ctx->RefCache.push_back(ImGuiTestRefCacheEntry());
+        ctx->RefCacheMap.SetInt(key, idx + 1);
+    }
+    ImGuiTestRefCacheEntry* entry = &ctx->RefCache[idx];
+
+    // Overwriting an entry for the same path (e.g. stale result resolved again): reuse its path copy
+    int path_offset = entry->PathOffset;
+    if (is_new || strcmp(ctx->RefCachePaths.begin() + path_offset, path) != 0)
+    {
+        path_offset = ctx->RefCachePaths.size();
+        ctx->RefCachePaths.append(path, path + strlen(path) + 1); // Include zero-terminator
+    }
+    *entry = ImGuiTestRefCacheEntry();
+    entry->Key = key;
+    entry->ID = id;
+    entry->PathOffset = path_offset;
+    return entry;
+}
+
+// Store window of last known item, so the entry may be dropped when the item window is destroyed
+static void ImGuiTestContext_RefCacheSetItem(ImGuiTestRefCacheEntry* entry, const ImGuiTestItemInfo* item)
+{
+    entry->WindowID = item->Window ? item->Window->ID : 0;
+}
+
+void ImGuiTestContext::RefCacheClear()
+{
+    RefCache.clear();
+    RefCacheMap.Clear();
+    RefCachePaths.clear();
+}
+
 ImGuiID ImGuiTestContext::GetID(ImGuiTestRef ref)
 {
     if (ref.ID)
@@ -799,105 +870,197 @@ bool ImGuiTestContext::CaptureEndVideo()
     return ret;
 }
 
-// Supported values for ImGuiTestOpFlags:
-// - ImGuiTestOpFlags_NoError
-ImGuiTestItemInfo* ImGuiTestContext::ItemInfo(ImGuiTestRef ref, ImGuiTestOpFlags flags)
+static void ImGuiTestContext_ErrorItemNotFound(ImGuiTestContext* ctx, const ImGuiTestRef& ref, ImGuiID full_id)
 {
-    if (IsError())
-        return NULL;
+    // Prefixing the string with / ignore the reference/current ID
+    if (ref.Path && ref.Path[0] == '/' && ctx->RefStr[0] != 0)
+        IM_ERRORF_NOHDR("Unable to locate item: '%s'", ref.Path);
+    else if (ref.Path)
+        IM_ERRORF_NOHDR("Unable to locate item: '%s/%s' (0x%08X)", ctx->RefStr, ref.Path, full_id);
+    else
+        IM_ERRORF_NOHDR("Unable to locate item: 0x%08X", ref.ID);
+}
 
-    ImGuiID full_id = 0;
+// Return pointer to the "**/" separator of a wildcard path, or NULL.
+// FIXME-TESTS: Need to verify that this is not inhibited by a \, so \**/ should not pass, but \\**/ should :)
+// We could add a simple helpers that would iterate the strings, handling inhibitors, and let you check if a given characters is inhibited or not.
+static const char* ImGuiTestContext_FindWildcard(const ImGuiTestRef& ref)
+{
+    return ref.Path ? strstr(ref.Path, "**/") : NULL;
+}
 
-    // Wildcard matching
-    // FIXME-TESTS: Need to verify that this is not inhibited by a \, so \**/ should not pass, but \\**/ should :)
-    // We could add a simple helpers that would iterate the strings, handling inhibitors, and let you check if a given characters is inhibited or not.
-    const char* wildcard_prefix_start = NULL;
-    const char* wildcard_prefix_end = NULL;
-    const char* wildcard_suffix_start = NULL;
-    if (ref.Path)
-        if (const char* p = strstr(ref.Path, "**/"))
+static void ImGuiTestContext_InitFindByLabelTask(ImGuiTestContext* ctx, ImGuiTestFindByLabelTask* task, const char* path, const char* wildcard)
+{
+    // Note that task->InPrefixId may be 0 as well (= we don't know the window)
+    const char* wildcard_prefix_start = path;
+    const char* wildcard_prefix_end = wildcard;
+    const char* wildcard_suffix_start = wildcard_prefix_end + 3;
+    if (wildcard_prefix_start < wildcard_prefix_end)
+        task->InPrefixId = ImHashDecoratedPath(wildcard_prefix_start, wildcard_prefix_end, ctx->RefID);
+    else
+        task->InPrefixId = ctx->RefID;
+    task->OutItemId = 0;
+    task->OutItemWindow = NULL;
+
+    // Advance pointer to point it to the last label
+    task->InSuffix = task->InSuffixLastItem = wildcard_suffix_start;
+    for (const char* c = task->InSuffix; *c; c++)
+        if (*c == '/')
+            task->InSuffixLastItem = c + 1;
+    task->InSuffixLastItemHash = ImHashStr(task->InSuffixLastItem, 0, 0);
+
+    // Count number of labels
+    task->InSuffixDepth = 1;
+    for (const char* c = wildcard_suffix_start; *c; c++)
+        if (*c == '/')
+            task->InSuffixDepth++;
+
+    // Set by ItemAction() to resolve ambiguities
+    task->InFilterItemStatusFlags = ctx->Engine->FindByLabelFilterItemStatusFlags;
+}
+
+// Resolve wildcard references (e.g. "**/foo/bar") to item IDs. All queries are registered at once and matched in the same frames.
+// - out_ids[n] is 0 when refs[n] is not a wildcard reference or when it couldn't be resolved.
+// - Return number of resolved wildcard references.
+static int ImGuiTestContext_ResolveWildcardRefs(ImGuiTestContext* ctx, const ImGuiTestRef* refs, int count, ImGuiID* out_ids)
+{
+    ImGuiTestEngine* engine = ctx->Engine;
+    ImVector<ImGuiTestFindByLabelTask> tasks;
+    tasks.resize(count, ImGuiTestFindByLabelTask());
+    int pending_count = 0;
+    for (int n = 0; n < count; n++)
+    {
+        out_ids[n] = 0;
+        if (const char* wildcard = ImGuiTestContext_FindWildcard(refs[n]))
         {
-            wildcard_prefix_start = ref.Path;
-            wildcard_prefix_end = p;
-            wildcard_suffix_start = wildcard_prefix_end + 3;
+            ImGuiTestContext_InitFindByLabelTask(ctx, &tasks[n], refs[n].Path, wildcard);
+            ImGuiTestEngine_AddFindByLabelTask(engine, &tasks[n]);
+            pending_count++;
         }
+    }
+    if (pending_count == 0)
+        return 0;
 
-    if (wildcard_prefix_start)
+    auto update_pending_count = [&]()
     {
-        // Wildcard matching
-        // Note that task->InPrefixId may be 0 as well (= we don't know the window)
-        ImGuiTestFindByLabelTask* task = &Engine->FindByLabelTask;
-        if (wildcard_prefix_start < wildcard_prefix_end)
-            task->InPrefixId = ImHashDecoratedPath(wildcard_prefix_start, wildcard_prefix_end, RefID);
-        else
-            task->InPrefixId = RefID;
-        task->OutItemId = 0;
-
-        // Advance pointer to point it to the last label
-        task->InSuffix = task->InSuffixLastItem = wildcard_suffix_start;
-        for (const char* c = task->InSuffix; *c; c++)
-            if (*c == '/')
-                task->InSuffixLastItem = c + 1;
-        task->InSuffixLastItemHash = ImHashStr(task->InSuffixLastItem, 0, 0);
-
-        // Count number of labels
-        task->InSuffixDepth = 1;
-        for (const char* c = wildcard_suffix_start; *c; c++)
-            if (*c == '/')
-                task->InSuffixDepth++;
-
-        LogDebug("Wildcard matching..");
-        int retries = 0;
-        while (retries < 2 && task->OutItemId == 0)
+        pending_count = 0;
+        for (ImGuiTestFindByLabelTask& task : tasks)
+            if (task.InSuffix != NULL && task.OutItemId == 0)
+                pending_count++;
+    };
+    auto yield_until_resolved = [&]()
+    {
+        for (int retries = 0; retries < 2 && pending_count > 0; retries++)
         {
-            ImGuiTestEngine_Yield(Engine);
-            retries++;
+            ImGuiTestEngine_Yield(engine);
+            update_pending_count();
         }
+    };
 
-        // Wildcard matching requires item to be visible, because clipped items are unaware of their labels. Try panning through entire window, searching for target item.
-        // FIXME-TESTS: Scrollbar position restoration may be desirable, however it interferes with using found item.
-        if (task->OutItemId == 0)
-        {
-            ImGuiTestItemInfo* base_item = ItemInfo(task->InPrefixId, ImGuiTestOpFlags_NoError);
-            ImGuiWindow* window = base_item ? base_item->Window : GetWindowByRef(task->InPrefixId);
-            if (window)
-            {
-                ImVec2 rect_size = window->InnerRect.GetSize();
-                for (float scroll_x = 0.0f; task->OutItemId == 0; scroll_x += rect_size.x)
+    ctx->LogDebug("Wildcard matching %d item(s)..", pending_count);
+    yield_until_resolved();
+
+    // Clipped items are unaware of their labels: match them by ID instead, and have list clippers submit all their items.
+    if (pending_count > 0)
+    {
+        engine->FindByLabelSearchClipped = true;
+        yield_until_resolved();
+        engine->FindByLabelSearchClipped = false;
+
+        // Item may be outside of the clipper visible range: scroll to it so it gets submitted again
+        for (ImGuiTestFindByLabelTask& task : tasks)
+            if (ImGuiWindow* window = task.OutItemWindow)
+                if (!window->InnerClipRect.Contains(task.OutItemRect))
                 {
-                    for (float scroll_y = 0.0f; task->OutItemId == 0; scroll_y += rect_size.y)
-                    {
-                        window->Scroll.x = scroll_x;
-                        window->Scroll.y = scroll_y;
-
-                        retries = 0;
-                        while (retries < 2 && task->OutItemId == 0)
-                        {
-                            ImGuiTestEngine_Yield(Engine);
-                            retries++;
-                        }
-                        if (window->Scroll.y >= window->ScrollMax.y)
-                            break;
-                    }
-                    if (window->Scroll.x >= window->ScrollMax.x)
-                        break;
+                    ImVec2 item_pos = task.OutItemRect.GetCenter() - window->InnerRect.Min + window->Scroll;
+                    ImVec2 inner_size = window->InnerRect.GetSize();
+                    if (window->ScrollbarX)
+                        window->Scroll.x = ImClamp(item_pos.x - inner_size.x * 0.5f, 0.0f, window->ScrollMax.x);
+                    if (window->ScrollbarY)
+                        window->Scroll.y = ImClamp(item_pos.y - inner_size.y * 0.5f, 0.0f, window->ScrollMax.y);
                 }
+    }
+
+    // Wildcard matching requires item to be submitted. Last resort: try panning through entire window, searching for target item.
+    // FIXME-TESTS: Scrollbar position restoration may be desirable, however it interferes with using found item.
+    for (ImGuiTestFindByLabelTask& task : tasks)
+    {
+        if (task.InSuffix == NULL || task.OutItemId != 0)
+            continue;
+        ImGuiTestItemInfo* base_item = ctx->ItemInfo(task.InPrefixId, ImGuiTestOpFlags_NoError);
+        ImGuiWindow* window = base_item ? base_item->Window : ctx->GetWindowByRef(task.InPrefixId);
+        if (window == NULL)
+            continue;
+        ImVec2 rect_size = window->InnerRect.GetSize();
+        for (float scroll_x = 0.0f; task.OutItemId == 0; scroll_x += rect_size.x)
+        {
+            for (float scroll_y = 0.0f; task.OutItemId == 0; scroll_y += rect_size.y)
+            {
+                window->Scroll.x = scroll_x;
+                window->Scroll.y = scroll_y;
+                for (int retries = 0; retries < 2 && task.OutItemId == 0; retries++)
+                    ImGuiTestEngine_Yield(engine);
+                if (window->Scroll.y >= window->ScrollMax.y)
+                    break;
             }
+            if (window->Scroll.x >= window->ScrollMax.x)
+                break;
+        }
+    }
+
+    int resolved_count = 0;
+    for (int n = 0; n < count; n++)
+        if (tasks[n].InSuffix != NULL)
+        {
+            ImGuiTestEngine_RemoveFindByLabelTask(engine, &tasks[n]);
+            out_ids[n] = tasks[n].OutItemId;
+            if (out_ids[n] != 0)
+                resolved_count++;
         }
-        full_id = task->OutItemId;
+    return resolved_count;
+}
 
-        // FIXME: InFilterItemStatusFlags is intentionally not cleared here, because it is set in ItemAction() and reused in later calls to ItemInfo() to resolve ambiguities.
-        task->InPrefixId = 0;
-        task->InSuffix = task->InSuffixLastItem = NULL;
-        task->InSuffixLastItemHash = 0;
-        task->InSuffixDepth = 0;
-        task->OutItemId = 0;    // -V1048   // Variable 'OutItemId' was assigned the same value. False-positive, because value of OutItemId could be modified from other thread during ImGuiTestEngine_Yield() call.
+// Supported values for ImGuiTestOpFlags:
+// - ImGuiTestOpFlags_NoError
+ImGuiTestItemInfo* ImGuiTestContext::ItemInfo(ImGuiTestRef ref, ImGuiTestOpFlags flags)
+{
+    if (IsError())
+        return NULL;
+
+    // Cache entries are referred to by index, as GuiFunc may add entries while we are yielding
+    ImGuiID full_id = 0;
+    int cache_idx = -1;
+    bool cache_hit = false;
+    if (ImGuiTestContext_FindWildcard(ref))
+    {
+        // Wildcard matching (reuse previous result if the same query was made with the same reference and filter)
+        ImGuiTestRefCacheEntry* cache_entry = ImGuiTestContext_RefCacheFind(this, ref.Path);
+        if (cache_entry && cache_entry->FilterItemStatusFlags == Engine->FindByLabelFilterItemStatusFlags)
+        {
+            RefCacheHits++;
+            full_id = cache_entry->ID;
+            cache_hit = true;
+        }
+        else
+        {
+            RefCacheMisses++;
+            cache_entry = NULL;
+            ImGuiTestContext_ResolveWildcardRefs(this, &ref, 1, &full_id);
+            if (full_id != 0)
+            {
+                cache_entry = ImGuiTestContext_RefCacheAdd(this, ref.Path, full_id);
+                cache_entry->FilterItemStatusFlags = Engine->FindByLabelFilterItemStatusFlags;
+            }
+        }
+        if (cache_entry && cache_entry->ID == full_id)
+            cache_idx = RefCache.index_from_ptr(cache_entry);
     }
     else
     {
         // Normal matching
         full_id = GetID(ref);
     }
+    const ImGuiID cache_key = (cache_idx != -1) ? RefCache[cache_idx].Key : 0;
 
     // If ui_ctx->TestEngineHooksEnabled is not already on (first ItemItem task in a while) we'll probably need an extra frame to warmup
     IMGUI_TEST_CONTEXT_REGISTER_DEPTH(this);
@@ -907,25 +1070,75 @@ ImGuiTestItemInfo* ImGuiTestContext::ItemInfo(ImGuiTestRef ref, ImGuiTestOpFlags
     {
         item = ImGuiTestEngine_FindItemInfo(Engine, full_id, ref.Path);
         if (item)
+        {
+            if (cache_idx != -1 && cache_idx < RefCache.Size && RefCache[cache_idx].Key == cache_key)
+                ImGuiTestContext_RefCacheSetItem(&RefCache[cache_idx], item);
             return item;
+        }
         ImGuiTestEngine_Yield(Engine);
         retries++;
     }
 
-    if (!(flags & ImGuiTestOpFlags_NoError))
+    // Cached wildcard result is stale (e.g. another item now matches the same path): drop it and search again
+    if (cache_hit)
     {
-        // Prefixing the string with / ignore the reference/current ID
-        if (ref.Path && ref.Path[0] == '/' && RefStr[0] != 0)
-            IM_ERRORF_NOHDR("Unable to locate item: '%s'", ref.Path);
-        else if (ref.Path)
-            IM_ERRORF_NOHDR("Unable to locate item: '%s/%s' (0x%08X)", RefStr, ref.Path, full_id);
-        else
-            IM_ERRORF_NOHDR("Unable to locate item: 0x%08X", ref.ID);
+        if (cache_idx < RefCache.Size && RefCache[cache_idx].Key == cache_key)
+            RefCache[cache_idx].Key = 0;
+        return ItemInfo(ref, flags);
     }
 
+    if (!(flags & ImGuiTestOpFlags_NoError))
+        ImGuiTestContext_ErrorItemNotFound(this, ref, full_id);
+
     return NULL;
 }
 
+// Query multiple items at once.
+// All info tasks are registered in the same frame and resolved together, so the whole batch costs the same number
+// of frames as a single ItemInfo() call, instead of up to two frames per item.
+// Wildcard refs ("**/") are resolved into an ID first (see ItemInfo()), and then joined to the batch.
+// Supported values for ImGuiTestOpFlags:
+// - ImGuiTestOpFlags_NoError
+int ImGuiTestContext::ItemInfoBatch(const ImGuiTestRef* refs, int count, ImGuiTestItemInfo** out_items, ImGuiTestOpFlags flags)
+{
+    IM_ASSERT(count >= 0);
+    for (int n = 0; n < count; n++)
+        out_items[n] = NULL;
+    if (IsError())
+        return 0;
+
+    IMGUI_TEST_CONTEXT_REGISTER_DEPTH(this);
+    LogDebug("ItemInfoBatch %d items", count);
+
+    // Wildcard references are all resolved together
+    ImVector<ImGuiID> ids;
+    ids.resize(count);
+    ImGuiTestContext_ResolveWildcardRefs(this, refs, count, ids.Data);
+    for (int n = 0; n < count; n++)
+        if (!ImGuiTestContext_FindWildcard(refs[n]))
+            ids[n] = GetID(refs[n]);
+
+    // Same retry policy as ItemInfo(): first query will register the tasks, next frames will fill them.
+    int found_count = 0;
+    for (int retries = 0; retries <= 2; retries++)
+    {
+        for (int n = 0; n < count; n++)
+            if (out_items[n] == NULL && ids[n] != 0)
+                if ((out_items[n] = ImGuiTestEngine_FindItemInfo(Engine, ids[n], refs[n].Path)) != NULL)
+                    found_count++;
+        if (found_count == count || retries == 2)
+            break;
+        ImGuiTestEngine_Yield(Engine);
+    }
+
+    if (!(flags & ImGuiTestOpFlags_NoError))
+        for (int n = 0; n < count; n++)
+            if (out_items[n] == NULL)
+                ImGuiTestContext_ErrorItemNotFound(this, refs[n], ids[n]);
+
+    return found_count;
+}
+
 ImGuiTestItemInfo* ImGuiTestContext::ItemInfoOpenFullPath(ImGuiTestRef ref)
 {
     // First query
@@ -2236,46 +2449,66 @@ bool    ImGuiTestContext::WindowBringToFront(ImGuiTestRef ref, ImGuiTestOpFlags
 }
 
 void    ImGuiTestContext::GatherItems(ImGuiTestItemList* out_list, ImGuiTestRef parent, int depth)
+{
+    IM_ASSERT(Engine->GatherTasksCount == 0 && "Use GatherItemsBegin()/GatherItemsEnd() to run multiple gathers.");
+    GatherItemsBegin(out_list, parent, depth);
+    GatherItemsEnd();
+}
+
+void    ImGuiTestContext::GatherItemsBegin(ImGuiTestItemList* out_list, ImGuiTestRef parent, int depth)
 {
     IM_ASSERT(out_list != NULL);
     IM_ASSERT(depth > 0 || depth == -1);
-    IM_ASSERT(GatherTask->InParentID == 0);
-    IM_ASSERT(GatherTask->LastItemInfo == NULL);
+    IM_ASSERT(Engine->GatherTasksCount < IM_ARRAYSIZE(Engine->GatherTasks) && "Too many simultaneous gather tasks!");
 
     if (IsError())
         return;
 
-    // Register gather tasks
+    // Register gather task
     if (depth == -1)
         depth = 99;
     if (parent.ID == 0)
         parent.ID = GetID(parent);
-    GatherTask->InParentID = parent.ID;
-    GatherTask->InDepth = depth;
-    GatherTask->OutList = out_list;
+    ImGuiTestGatherTask* task = &Engine->GatherTasks[Engine->GatherTasksCount++];
+    task->InParentID = parent.ID;
+    task->InDepth = depth;
+    task->OutList = out_list;
+    task->LastItemInfo = NULL;
+    task->OutListStartSize = out_list->GetSize();
+}
 
-    // Keep running while gathering
-    const int begin_gather_size = out_list->GetSize();
-    while (true)
+void    ImGuiTestContext::GatherItemsEnd()
+{
+    // Keep running while gathering (until none of the lists are growing)
+    ImGuiTestEngine* engine = Engine;
+    while (engine->GatherTasksCount > 0)
     {
-        const int begin_gather_size_for_frame = out_list->GetSize();
+        int begin_gather_size_for_frame = 0;
+        for (int task_n = 0; task_n < engine->GatherTasksCount; task_n++)
+            begin_gather_size_for_frame += engine->GatherTasks[task_n].OutList->GetSize();
         Yield();
-        const int end_gather_size_for_frame = out_list->GetSize();
+        int end_gather_size_for_frame = 0;
+        for (int task_n = 0; task_n < engine->GatherTasksCount; task_n++)
+            end_gather_size_for_frame += engine->GatherTasks[task_n].OutList->GetSize();
         if (begin_gather_size_for_frame == end_gather_size_for_frame)
             break;
     }
-    const int end_gather_size = out_list->GetSize();
 
     // FIXME-TESTS: To support filter we'd need to process the list here,
     // Because ImGuiTestItemList is a pool (ImVector + map ID->index) we'll need to filter, rewrite, rebuild map
 
-    ImGuiTestItemInfo* parent_item = ItemInfo(parent, ImGuiTestOpFlags_NoError);
-    LogDebug("GatherItems from %s, %d deep: found %d items.", ImGuiTestRefDesc(parent, parent_item).c_str(), depth, end_gather_size - begin_gather_size);
+    for (int task_n = 0; task_n < engine->GatherTasksCount; task_n++)
+    {
+        ImGuiTestGatherTask* task = &engine->GatherTasks[task_n];
+        ImGuiTestItemInfo* parent_item = task->InParentID ? ImGuiTestEngine_FindItemInfo(engine, task->InParentID, NULL) : NULL;
+        LogDebug("GatherItems from %s, %d deep: found %d items.", ImGuiTestRefDesc(task->InParentID, parent_item).c_str(), task->InDepth, task->OutList->GetSize() - task->OutListStartSize);
 
-    GatherTask->InParentID = 0;
-    GatherTask->InDepth = 0;
-    GatherTask->OutList = NULL;
-    GatherTask->LastItemInfo = NULL;
+        task->InParentID = 0;
+        task->InDepth = 0;
+        task->OutList = NULL;
+        task->LastItemInfo = NULL;
+    }
+    engine->GatherTasksCount = 0;
 }
 
 void    ImGuiTestContext::ItemAction(ImGuiTestAction action, ImGuiTestRef ref, void* action_arg, ImGuiTestOpFlags flags)
@@ -2295,11 +2528,11 @@ void    ImGuiTestContext::ItemAction(ImGuiTestAction action, ImGuiTestRef ref, v
     {
         // This is a fragile way to avoid some ambiguities, we're relying on expected action to further filter by status flags.
         // These flags are not cleared by ItemInfo() because ItemAction() may call ItemInfo() again to get same item and thus it
-        // needs these flags to remain in place.
+        // needs these flags to remain in place. They are copied into each wildcard query when it is registered.
         if (action == ImGuiTestAction_Check || action == ImGuiTestAction_Uncheck)
-            Engine->FindByLabelTask.InFilterItemStatusFlags = ImGuiItemStatusFlags_Checkable;
+            Engine->FindByLabelFilterItemStatusFlags = ImGuiItemStatusFlags_Checkable;
         else if (action == ImGuiTestAction_Open || action == ImGuiTestAction_Close)
-            Engine->FindByLabelTask.InFilterItemStatusFlags = ImGuiItemStatusFlags_Openable;
+            Engine->FindByLabelFilterItemStatusFlags = ImGuiItemStatusFlags_Openable;
     }
 
     ImGuiTestItemInfo* item;
@@ -2424,7 +2657,7 @@ void    ImGuiTestContext::ItemAction(ImGuiTestAction action, ImGuiTestRef ref, v
     }
 
     //if (is_wildcard)
-        Engine->FindByLabelTask.InFilterItemStatusFlags = ImGuiItemStatusFlags_None;
+        Engine->FindByLabelFilterItemStatusFlags = ImGuiItemStatusFlags_None;
 }
 
 void    ImGuiTestContext::ItemActionAll(ImGuiTestAction action, ImGuiTestRef ref_parent, const ImGuiTestActionFilter* filter)
@@ -73,6 +73,18 @@ struct IMGUI_API ImGuiTestRefDesc
     ImGuiTestRefDesc(const ImGuiTestRef& ref, const ImGuiTestItemInfo* item);
 };
 
+// Cached resolution of a wildcard path relative to the current reference (see ImGuiTestContext::ItemInfo())
+// Plain paths are not cached: hashing them is cheaper than a lookup. The cache is cleared by SetRef().
+// Entries are dropped when the window of the last known item is destroyed.
+struct IMGUI_API ImGuiTestRefCacheEntry
+{
+    ImGuiID                 Key = 0;                    // Hash of (RefID, Path), 0 if entry was dropped
+    ImGuiID                 ID = 0;                     // Resolved ID
+    ImGuiID                 WindowID = 0;               // Window of last known item (0 if unknown)
+    int                     PathOffset = 0;             // Offset of path copy in ImGuiTestContext::RefCachePaths
+    ImGuiItemStatusFlags    FilterItemStatusFlags = 0;  // Status flags used for wildcard matching
+};
+
 //-------------------------------------------------------------------------
 // [SECTION] Helper keys
 //-------------------------------------------------------------------------
@@ -227,7 +239,6 @@ struct IMGUI_API ImGuiTestContext
 
     ImGuiTestEngine*        Engine = NULL;
     ImGuiTestInputs*        Inputs = NULL;
-    ImGuiTestGatherTask*    GatherTask = NULL;
     ImGuiTestRunFlags       RunFlags = ImGuiTestRunFlags_None;
     ImGuiTestActiveFunc     ActiveFunc = ImGuiTestActiveFunc_None;  // None/GuiFunc/TestFunc
     double                  RunningTime = 0.0;                      // Amount of wall clock time the Test has been running. Used by safety watchdog.
@@ -239,6 +250,11 @@ struct IMGUI_API ImGuiTestContext
     double                  PerfRefDt = -1.0;
     char                    RefStr[256] = { 0 };                    // Reference window/path for ID construction
     ImGuiID                 RefID = 0;
+    ImVector<ImGuiTestRefCacheEntry> RefCache;                      // Resolved wildcard paths relative to RefID (see ImGuiTestRefCacheEntry)
+    ImGuiStorage            RefCacheMap;                            // Key -> index+1 into RefCache[]
+    ImGuiTextBuffer         RefCachePaths;                          // Zero-terminated copies of cached paths
+    int                     RefCacheHits = 0;                       // Number of wildcard lookups served by RefCache (ItemInfo())
+    int                     RefCacheMisses = 0;                     // Number of wildcard lookups which needed matching
     ImGuiInputSource        InputMode = ImGuiInputSource_Mouse;     // Prefer interacting with mouse/keyboard/gamepad
     ImVector<char>          Clipboard;                              // Private clipboard for the test instance
     ImVector<ImGuiWindow*>  ForeignWindowsToHide;
@@ -310,6 +326,7 @@ struct IMGUI_API ImGuiTestContext
     ImGuiID     GetIDByInt(int n, ImGuiTestRef seed_ref);
     ImGuiID     GetIDByPtr(void* p);
     ImGuiID     GetIDByPtr(void* p, ImGuiTestRef seed_ref);
+    void        RefCacheClear();
     ImGuiID     GetChildWindowID(ImGuiTestRef parent_ref, const char* child_name);  // Name created by BeginChild("name", ...), using specified parent.
     ImGuiID     GetChildWindowID(ImGuiTestRef parent_ref, ImGuiID child_id);        // Name created by BeginChild(id, ...), using specified parent.
 
@@ -388,7 +405,10 @@ struct IMGUI_API ImGuiTestContext
     // Low-level queries
     ImGuiTestItemInfo*  ItemInfo(ImGuiTestRef ref, ImGuiTestOpFlags flags = ImGuiTestOpFlags_None);             // Important: always test for NULL!
     ImGuiTestItemInfo*  ItemInfoOpenFullPath(ImGuiTestRef ref);
+    int                 ItemInfoBatch(const ImGuiTestRef* refs, int count, ImGuiTestItemInfo** out_items, ImGuiTestOpFlags flags = ImGuiTestOpFlags_None); // Resolve multiple items in the same frames. Return number of items found, missing ones are NULL.
     void                GatherItems(ImGuiTestItemList* out_list, ImGuiTestRef parent, int depth = -1);
+    void                GatherItemsBegin(ImGuiTestItemList* out_list, ImGuiTestRef parent, int depth = -1);  // Start gathering without waiting. Multiple gathers may be started, then all completed together by GatherItemsEnd().
+    void                GatherItemsEnd();
 
     // Item/Widgets manipulation
     void        ItemAction(ImGuiTestAction action, ImGuiTestRef ref, void* action_arg = NULL, ImGuiTestOpFlags flags = 0);
@@ -160,4 +160,303 @@ ImGuiTestCoroutineInterface* Coroutine_ImplStdThread_GetInterface()
     return &intf;
 }
 
+//------------------------------------------------------------------------
+// Coroutine implementation using std::thread with spin-then-futex handoff (Linux only)
+// Same as above, but the handoff is an atomic state word: the waiting thread spins for a short while before parking on a futex,
+// and the running thread only issues a wake-up syscall when the other thread is parked. Short handoffs don't involve the OS scheduler.
+//------------------------------------------------------------------------
+
+#if defined(__linux__)
+
+#include <atomic>
+#include <limits.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define IM_COROUTINE_CPU_RELAX()    __builtin_ia32_pause()
+#elif defined(__aarch64__) || defined(__arm__)
+#define IM_COROUTINE_CPU_RELAX()    __asm__ volatile("yield")
+#else
+#define IM_COROUTINE_CPU_RELAX()    do { } while (0)
+#endif
+
+enum Coroutine_ImplStdThreadFutexState
+{
+    Coroutine_ImplStdThreadFutexState_Caller,       // Caller of Run() is running, coroutine is waiting
+    Coroutine_ImplStdThreadFutexState_Coroutine,    // Coroutine is running, caller of Run() is waiting
+    Coroutine_ImplStdThreadFutexState_Terminated,   // Coroutine has terminated
+};
+
+struct Coroutine_ImplStdThreadFutexData
+{
+    std::thread*            Thread;                 // The thread this coroutine is using
+    std::atomic<int>        State;                  // Which side is running (see Coroutine_ImplStdThreadFutexState), also used as futex word
+    std::atomic<int>        ParkedCount;            // Number of threads parked (or about to park) on the futex
+    int                     SpinCount;              // Number of iterations spent polling State before parking (0 on single core machines where spinning can't succeed)
+    Str64                   Name;                   // The name of this coroutine
+};
+
+// The coroutine executing on the current thread (if it is a coroutine thread)
+static thread_local Coroutine_ImplStdThreadFutexData* GThreadFutexCoroutine = NULL;
+
+// Publish new state, wake up other thread if it is parked
+static void Coroutine_ImplStdThreadFutex_SetState(Coroutine_ImplStdThreadFutexData* data, int state)
+{
+    data->State.store(state);
+    if (data->ParkedCount.load() > 0)
+        syscall(SYS_futex, (int*)&data->State, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+// Wait until state changes from 'state', return new state
+static int Coroutine_ImplStdThreadFutex_WaitWhile(Coroutine_ImplStdThreadFutexData* data, int state)
+{
+    for (int n = 0; n < data->SpinCount; n++)
+    {
+        int new_state = data->State.load(std::memory_order_acquire);
+        if (new_state != state)
+            return new_state;
+        IM_COROUTINE_CPU_RELAX();
+    }
+    while (1)
+    {
+        // Incrementing ParkedCount before checking State (both sequentially consistent) ensures SetState() can't miss us.
+        data->ParkedCount.fetch_add(1);
+        if (data->State.load() == state)
+            syscall(SYS_futex, (int*)&data->State, FUTEX_WAIT_PRIVATE, state, NULL, NULL, 0); // Returns immediately if State != state
+        data->ParkedCount.fetch_sub(1);
+        int new_state = data->State.load(std::memory_order_acquire);
+        if (new_state != state)
+            return new_state;
+    }
+}
+
+// The main function for a coroutine thread
+static void CoroutineFutexThreadMain(Coroutine_ImplStdThreadFutexData* data, ImGuiTestCoroutineMainFunc func, void* ctx)
+{
+    ImThreadSetCurrentThreadDescription(data->Name.c_str());
+    GThreadFutexCoroutine = data;
+
+    // Wait for initial Run()
+    Coroutine_ImplStdThreadFutex_WaitWhile(data, Coroutine_ImplStdThreadFutexState_Caller);
+
+    // Run user code, which will then call Yield() when it wants to yield control
+    func(ctx);
+
+    // Mark as terminated
+    Coroutine_ImplStdThreadFutex_SetState(data, Coroutine_ImplStdThreadFutexState_Terminated);
+}
+
+static ImGuiTestCoroutineHandle Coroutine_ImplStdThreadFutex_Create(ImGuiTestCoroutineMainFunc* func, const char* name, void* ctx)
+{
+    Coroutine_ImplStdThreadFutexData* data = new Coroutine_ImplStdThreadFutexData();
+
+    data->Name = name;
+    data->State = Coroutine_ImplStdThreadFutexState_Caller;
+    data->ParkedCount = 0;
+    data->SpinCount = (std::thread::hardware_concurrency() > 1) ? IMGUI_TEST_ENGINE_COROUTINE_FUTEX_SPIN_COUNT : 0;
+    data->Thread = new std::thread(CoroutineFutexThreadMain, data, func, ctx);
+
+    return (ImGuiTestCoroutineHandle)data;
+}
+
+static void Coroutine_ImplStdThreadFutex_Destroy(ImGuiTestCoroutineHandle handle)
+{
+    Coroutine_ImplStdThreadFutexData* data = (Coroutine_ImplStdThreadFutexData*)handle;
+
+    IM_ASSERT(data->State == Coroutine_ImplStdThreadFutexState_Terminated); // The coroutine needs to run to termination otherwise it may leak all sorts of things and this will deadlock
+    data->Thread->join();
+    delete data->Thread;
+    delete data;
+}
+
+// Run the coroutine until the next call to Yield(). Returns TRUE if the coroutine yielded, FALSE if it terminated (or had previously terminated)
+static bool Coroutine_ImplStdThreadFutex_Run(ImGuiTestCoroutineHandle handle)
+{
+    Coroutine_ImplStdThreadFutexData* data = (Coroutine_ImplStdThreadFutexData*)handle;
+    if (data->State.load(std::memory_order_acquire) == Coroutine_ImplStdThreadFutexState_Terminated)
+        return false; // Coroutine has already finished
+
+    Coroutine_ImplStdThreadFutex_SetState(data, Coroutine_ImplStdThreadFutexState_Coroutine);
+    int state = Coroutine_ImplStdThreadFutex_WaitWhile(data, Coroutine_ImplStdThreadFutexState_Coroutine);
+    return state != Coroutine_ImplStdThreadFutexState_Terminated;
+}
+
+// Yield the current coroutine (can only be called from a coroutine)
+static void Coroutine_ImplStdThreadFutex_Yield()
+{
+    IM_ASSERT(GThreadFutexCoroutine); // This can only be called from a coroutine thread
+
+    Coroutine_ImplStdThreadFutexData* data = GThreadFutexCoroutine;
+    Coroutine_ImplStdThreadFutex_SetState(data, Coroutine_ImplStdThreadFutexState_Caller);
+    Coroutine_ImplStdThreadFutex_WaitWhile(data, Coroutine_ImplStdThreadFutexState_Caller);
+}
+
+ImGuiTestCoroutineInterface* Coroutine_ImplStdThreadFutex_GetInterface()
+{
+    static ImGuiTestCoroutineInterface intf;
+    intf.CreateFunc = Coroutine_ImplStdThreadFutex_Create;
+    intf.DestroyFunc = Coroutine_ImplStdThreadFutex_Destroy;
+    intf.RunFunc = Coroutine_ImplStdThreadFutex_Run;
+    intf.YieldFunc = Coroutine_ImplStdThreadFutex_Yield;
+    return &intf;
+}
+
+#endif // #if defined(__linux__)
+
 #endif // #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+
+//------------------------------------------------------------------------
+// Coroutine implementation using ucontext
+// This implements a coroutine by switching stacks on the calling thread with swapcontext(), so Run()/Yield() don't involve
+// the OS scheduler. Each coroutine gets its own mmap()-ed stack with a guard page.
+//------------------------------------------------------------------------
+
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+
+#if defined(_WIN32)
+#error "IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL is not supported on Windows."
+#endif
+
+// On macOS, this file needs to be compiled with -D_XOPEN_SOURCE=600 for <ucontext.h> to be usable.
+#include "thirdparty/Str/Str.h"
+#include <ucontext.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <mutex>
+
+struct Coroutine_ImplUcontextData
+{
+    ucontext_t                  CoroutineContext;       // Context of the coroutine (saved by Yield())
+    ucontext_t                  CallerContext;          // Context of the caller of Run() (saved by Run(), restored by Yield() and when coroutine function returns)
+    void*                       StackMemory;            // Stack memory, including guard page
+    size_t                      StackMemorySize;
+    ImGuiTestCoroutineMainFunc* Func;
+    void*                       Ctx;
+    bool                        CoroutineRunning;       // Is the coroutine currently running?
+    bool                        CoroutineTerminated;    // Has the coroutine terminated?
+    Str64                       Name;                   // The name of this coroutine
+};
+
+// Interfaces returned by Coroutine_ImplUcontext_GetInterface(), one per requested stack size.
+// The interface doesn't carry user data, so each slot has its own CreateFunc reading the stack size of that slot.
+static ImGuiTestCoroutineInterface  GUcontextInterfaces[4];
+static size_t                       GUcontextInterfacesStackSize[IM_ARRAYSIZE(GUcontextInterfaces)];
+static std::mutex                   GUcontextInterfacesMutex;
+
+// The coroutine executing on the current thread (if any)
+static thread_local Coroutine_ImplUcontextData* GUcontextCoroutine = NULL;
+
+// Entry point of a coroutine (makecontext() only portably passes int arguments, so we retrieve data from GUcontextCoroutine set by Run())
+static void Coroutine_ImplUcontext_Main()
+{
+    Coroutine_ImplUcontextData* data = GUcontextCoroutine;
+    data->Func(data->Ctx);
+
+    // Mark as terminated. Returning will resume CallerContext (uc_link)
+    data->CoroutineTerminated = true;
+    data->CoroutineRunning = false;
+}
+
+static ImGuiTestCoroutineHandle Coroutine_ImplUcontext_CreateWithStackSize(ImGuiTestCoroutineMainFunc* func, const char* name, void* ctx, size_t requested_stack_size)
+{
+    const size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    const size_t stack_size = (requested_stack_size + page_size - 1) & ~(page_size - 1);
+
+    Coroutine_ImplUcontextData* data = new Coroutine_ImplUcontextData();
+    data->Name = name;
+    data->Func = func;
+    data->Ctx = ctx;
+    data->CoroutineRunning = false;
+    data->CoroutineTerminated = false;
+
+    // Allocate stack with a guard page at the bottom, so overflows crash instead of corrupting memory
+    data->StackMemorySize = stack_size + page_size;
+    data->StackMemory = mmap(NULL, data->StackMemorySize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    IM_ASSERT(data->StackMemory != MAP_FAILED);
+    mprotect(data->StackMemory, page_size, PROT_NONE);
+
+    getcontext(&data->CoroutineContext);
+    data->CoroutineContext.uc_stack.ss_sp = (char*)data->StackMemory + page_size;
+    data->CoroutineContext.uc_stack.ss_size = stack_size;
+    data->CoroutineContext.uc_link = &data->CallerContext;
+    makecontext(&data->CoroutineContext, Coroutine_ImplUcontext_Main, 0);
+
+    return (ImGuiTestCoroutineHandle)data;
+}
+
+template<int INTERFACE_N>
+static ImGuiTestCoroutineHandle Coroutine_ImplUcontext_Create(ImGuiTestCoroutineMainFunc* func, const char* name, void* ctx)
+{
+    return Coroutine_ImplUcontext_CreateWithStackSize(func, name, ctx, GUcontextInterfacesStackSize[INTERFACE_N]);
+}
+
+static void Coroutine_ImplUcontext_Destroy(ImGuiTestCoroutineHandle handle)
+{
+    Coroutine_ImplUcontextData* data = (Coroutine_ImplUcontextData*)handle;
+
+    IM_ASSERT(data->CoroutineTerminated); // The coroutine needs to run to termination otherwise it may leak all sorts of things
+    munmap(data->StackMemory, data->StackMemorySize);
+
+    delete data;
+    data = NULL;
+}
+
+// Run the coroutine until the next call to Yield(). Returns TRUE if the coroutine yielded, FALSE if it terminated (or had previously terminated)
+static bool Coroutine_ImplUcontext_Run(ImGuiTestCoroutineHandle handle)
+{
+    Coroutine_ImplUcontextData* data = (Coroutine_ImplUcontextData*)handle;
+    if (data->CoroutineTerminated)
+        return false; // Coroutine has already finished
+
+    // Support running a coroutine from another coroutine
+    Coroutine_ImplUcontextData* parent_coroutine = GUcontextCoroutine;
+    GUcontextCoroutine = data;
+    data->CoroutineRunning = true;
+    swapcontext(&data->CallerContext, &data->CoroutineContext);
+    GUcontextCoroutine = parent_coroutine;
+
+    // Breakpoint here to catch the point where we return from the coroutine
+    return !data->CoroutineTerminated;
+}
+
+// Yield the current coroutine (can only be called from a coroutine)
+static void Coroutine_ImplUcontext_Yield()
+{
+    Coroutine_ImplUcontextData* data = GUcontextCoroutine;
+    IM_ASSERT(data != NULL && data->CoroutineRunning); // This can only be called from a coroutine
+
+    data->CoroutineRunning = false;
+    swapcontext(&data->CoroutineContext, &data->CallerContext);
+    // Breakpoint here if you want to catch the point where execution of this coroutine resumes
+}
+
+ImGuiTestCoroutineInterface* Coroutine_ImplUcontext_GetInterface(size_t stack_size)
+{
+    if (stack_size == 0)
+        stack_size = IMGUI_TEST_ENGINE_COROUTINE_UCONTEXT_STACK_SIZE;
+
+    static ImGuiTestCoroutineHandle (*create_funcs[])(ImGuiTestCoroutineMainFunc*, const char*, void*) = { Coroutine_ImplUcontext_Create<0>, Coroutine_ImplUcontext_Create<1>, Coroutine_ImplUcontext_Create<2>, Coroutine_ImplUcontext_Create<3> };
+    static_assert(IM_ARRAYSIZE(create_funcs) == IM_ARRAYSIZE(GUcontextInterfaces), "");
+
+    std::lock_guard<std::mutex> lock(GUcontextInterfacesMutex);
+    for (int n = 0; n < IM_ARRAYSIZE(GUcontextInterfaces); n++)
+    {
+        ImGuiTestCoroutineInterface* intf = &GUcontextInterfaces[n];
+        if (intf->CreateFunc == NULL)
+        {
+            GUcontextInterfacesStackSize[n] = stack_size;
+            intf->CreateFunc = create_funcs[n];
+            intf->DestroyFunc = Coroutine_ImplUcontext_Destroy;
+            intf->RunFunc = Coroutine_ImplUcontext_Run;
+            intf->YieldFunc = Coroutine_ImplUcontext_Yield;
+        }
+        if (GUcontextInterfacesStackSize[n] == stack_size)
+            return intf;
+    }
+    IM_ASSERT(0 && "Too many different ucontext coroutine stack sizes!");
+    return NULL;
+}
+
+#endif // #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
@@ -12,6 +12,9 @@
 //   while (CoroutineRun(handle)) { <do other stuff };
 //   CoroutineDestroy(handle);
 // The coroutine code itself should call CoroutineYieldFunc() whenever it wants to yield control back to the main thread.
+// Note that yields happen from arbitrarily nested user code (e.g. TestFunc -> ctx->ItemClick() -> ctx->Yield()), so implementations
+// need to be stackful: C++20 stackless coroutines can't be used unless every function between TestFunc and Yield() becomes a coroutine.
+// Use the ucontext implementation below to yield without switching threads.
 //------------------------------------------------------------------------
 
 // An arbitrary handle used internally to represent coroutines (NULL indicates no handle)
@@ -39,4 +42,19 @@ struct IMGUI_API ImGuiTestCoroutineInterface
 
 #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
 IMGUI_API ImGuiTestCoroutineInterface*    Coroutine_ImplStdThread_GetInterface();
+#if defined(__linux__)
+// Variant handing off with an atomic state word: waiting thread spins for IMGUI_TEST_ENGINE_COROUTINE_FUTEX_SPIN_COUNT iterations before parking on a futex.
+IMGUI_API ImGuiTestCoroutineInterface*    Coroutine_ImplStdThreadFutex_GetInterface();
+#endif
 #endif // #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+
+//------------------------------------------------------------------------
+// Coroutine implementation using ucontext (POSIX only)
+// Coroutines run on their own stack on the thread calling CoroutineRun(): switching doesn't involve the OS scheduler.
+// Pass a non-zero stack_size to override IMGUI_TEST_ENGINE_COROUTINE_UCONTEXT_STACK_SIZE for coroutines created by the returned interface.
+// Note that debuggers and sanitizers generally don't know about stack switching and may produce confusing call-stacks.
+//------------------------------------------------------------------------
+
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+IMGUI_API ImGuiTestCoroutineInterface*    Coroutine_ImplUcontext_GetInterface(size_t stack_size = 0);
+#endif // #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
@@ -15,6 +15,10 @@
 #include "imgui_te_perftool.h"
 #include "imgui_te_exporters.h"
 #include "thirdparty/Str/Str.h"
+#if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
+#include "implot.h"     // ImPlot::GetCurrentContext()
+#endif
+#include <atomic>
 #if _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -74,7 +78,10 @@ Index of this file:
 // [SECTION] DATA
 //-------------------------------------------------------------------------
 
-static ImGuiTestEngine* GImGuiTestEngine = NULL;
+// Engine reported to by ImGuiTestEngine_Check()/ImGuiTestEngine_Error()/ImGuiTestEngine_Assert(), see ImGuiTestEngine_GetCurrentEngine().
+// Multiple engine+context pairs may run in parallel on their own threads (e.g. imgui_tests '-jobs N'), so this is resolved per thread/context.
+static std::atomic<ImGuiTestEngine*> GImGuiTestEngine(NULL);                    // First engine bound to a dear imgui context (fallback). Engines may be bound/unbound from multiple threads.
+static thread_local ImGuiTestEngine* GImGuiTestEngineCurrentThread = NULL;     // Engine whose test coroutine is running on this thread
 
 //-------------------------------------------------------------------------
 // [SECTION] FORWARD DECLARATIONS
@@ -84,7 +91,6 @@ static ImGuiTestEngine* GImGuiTestEngine = NULL;
 static void ImGuiTestEngine_BindImGuiContext(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
 static void ImGuiTestEngine_UnbindImGuiContext(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
 static void ImGuiTestEngine_CoroutineStopAndJoin(ImGuiTestEngine* engine);
-static void ImGuiTestEngine_StartCalcSourceLineEnds(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_ClearInput(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_ApplyInputToImGuiContext(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_ProcessTestQueue(ImGuiTestEngine* engine);
@@ -95,8 +101,11 @@ static void ImGuiTestEngine_PreRender(ImGuiTestEngine* engine, ImGuiContext* ui_
 static void ImGuiTestEngine_PostRender(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
 static void ImGuiTestEngine_UpdateHooks(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_RunGuiFunc(ImGuiTestEngine* engine);
+static bool ImGuiTestEngine_IsRenderNeeded(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
+static void ImGuiTestEngine_RunTurboFrames(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
 static void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* ctx);
 static void ImGuiTestEngine_TestQueueCoroutineMain(void* engine_opaque);
+static ImGuiTestEngine* ImGuiTestEngine_GetCurrentEngine();
 
 // Settings
 static void* ImGuiTestEngine_SettingsReadOpen(ImGuiContext*, ImGuiSettingsHandler*, const char* name);
@@ -134,10 +143,13 @@ ImGuiTestEngine::ImGuiTestEngine()
     PerfDeltaTime1000.Init(1000);
     PerfTool = IM_NEW(ImGuiPerfTool);
 
-    // Initialize std::thread based coroutine implementation if requested
+    // Initialize std::thread or ucontext based coroutine implementation if requested
 #if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
     IM_ASSERT(IO.CoroutineFuncs == NULL && "IO.CoroutineFuncs already setup elsewhere!");
     IO.CoroutineFuncs = Coroutine_ImplStdThread_GetInterface();
+#elif IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+    IM_ASSERT(IO.CoroutineFuncs == NULL && "IO.CoroutineFuncs already setup elsewhere!");
+    IO.CoroutineFuncs = Coroutine_ImplUcontext_GetInterface();
 #endif
 }
 
@@ -192,8 +204,8 @@ static void ImGuiTestEngine_BindImGuiContext(ImGuiTestEngine* engine, ImGuiConte
     ImGui::AddContextHook(ui_ctx, &hook);
 
     // Install custom test engine hook data
-    if (GImGuiTestEngine == NULL)
-        GImGuiTestEngine = engine;
+    ImGuiTestEngine* expected_engine = NULL;
+    GImGuiTestEngine.compare_exchange_strong(expected_engine, engine);
     IM_ASSERT(ui_ctx->TestEngine == NULL);
     ui_ctx->TestEngine = engine;
 }
@@ -230,9 +242,10 @@ static void    ImGuiTestEngine_UnbindImGuiContext(ImGuiTestEngine* engine, ImGui
 #endif
 
     // Remove hook
-    if (GImGuiTestEngine == engine)
-        GImGuiTestEngine = NULL;
+    ImGuiTestEngine* expected_engine = engine;
+    GImGuiTestEngine.compare_exchange_strong(expected_engine, NULL);
     engine->UiContextTarget = engine->UiContextActive = NULL;
+    engine->UiSnapshotValid = false;
 }
 
 // Create test context (not bound to any dear imgui context yet)
@@ -262,14 +275,19 @@ void    ImGuiTestEngine_DestroyContext(ImGuiTestEngine* engine)
     ImGuiTestEngine_ClearTests(engine);
 
     for (int n = 0; n < engine->InfoTasks.Size; n++)
-        IM_DELETE(engine->InfoTasks[n]);
+        engine->InfoTasksPool.Free(engine->InfoTasks[n]);
     engine->InfoTasks.clear();
+    engine->InfoTasksPool.Clear();
+    engine->InfoTasksIndex.clear();
+    memset(engine->InfoTasksFilter, 0, sizeof(engine->InfoTasksFilter));
 
     IM_DELETE(engine);
 
     // Release hook
-    if (GImGuiTestEngine == engine)
-        GImGuiTestEngine = NULL;
+    ImGuiTestEngine* expected_engine = engine;
+    GImGuiTestEngine.compare_exchange_strong(expected_engine, NULL);
+    if (GImGuiTestEngineCurrentThread == engine)
+        GImGuiTestEngineCurrentThread = NULL;
 }
 
 void    ImGuiTestEngine_Start(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
@@ -278,8 +296,11 @@ void    ImGuiTestEngine_Start(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
     IM_ASSERT(engine->UiContextTarget == NULL);
 
     engine->UiContextTarget = ui_ctx;
+#if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
+    engine->PlotContext = ImPlot::GetCurrentContext();
+#endif
     ImGuiTestEngine_BindImGuiContext(engine, engine->UiContextTarget);
-    ImGuiTestEngine_StartCalcSourceLineEnds(engine);
+    ImGuiTestEngine_CalcSourceLineEnds(engine);
 
     // Create our coroutine
     // (we include the word "Main" in the name to facilitate filtering for both this thread and the "Main Thread" in debuggers)
@@ -351,10 +372,12 @@ void    ImGuiTestEngine_RebootUiContext(ImGuiTestEngine* engine)
 #endif
 
     // Recreate
+    // (only this part is timed, so UiContextRebootTime compares with ImGuiTestEngine_RestoreUiSnapshot() without coroutine start/stop)
     ctx->FontAtlasOwnedByContext = false;
+    const ImU64 start_time = ImTimeGetInMicroseconds();
 #if 1
     ImGui::DestroyContext();
-    ImGui::CreateContext(backup_atlas);
+    ctx = ImGui::CreateContext(backup_atlas);
 #else
     // Preserve same context pointer, which is probably misleading and not even necessary.
     ImGui::Shutdown(ctx);
@@ -362,6 +385,7 @@ void    ImGuiTestEngine_RebootUiContext(ImGuiTestEngine* engine)
     IM_PLACEMENT_NEW(ctx) ImGuiContext(backup_atlas);
     ImGui::Initialize(ctx);
 #endif
+    engine->UiContextRebootTime = ImTimeGetInMicroseconds() - start_time;
 
     // Restore
     ctx->FontAtlasOwnedByContext = backup_atlas_owned_by_context;
@@ -379,6 +403,122 @@ void    ImGuiTestEngine_RebootUiContext(ImGuiTestEngine* engine)
     ImGuiTestEngine_Start(engine, ctx);
 }
 
+static bool ImGuiTestEngine_IsUiSnapshotSettingsHandler(const ImGuiSettingsHandler* handler)
+{
+    return handler->TypeHash == ImHashStr("Window") || handler->TypeHash == ImHashStr("Table") || handler->TypeHash == ImHashStr("Docking");
+}
+
+// Capture a lightweight snapshot of the UI context, to be restored by ImGuiTestEngine_RestoreUiSnapshot().
+// We store the output of the windows/tables/docking .ini handlers and the set of windows and tables which currently exist.
+// Anything not covered by settings (fonts, style, storage of existing windows) is left alone, which is what makes it cheap.
+void    ImGuiTestEngine_CaptureUiSnapshot(ImGuiTestEngine* engine)
+{
+    IM_ASSERT(engine->UiContextTarget != NULL);
+    ImGuiContext& g = *engine->UiContextTarget;
+    IM_ASSERT(GImGui == &g);
+
+    engine->UiSnapshotSettings.clear();
+    for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+        if (ImGuiTestEngine_IsUiSnapshotSettingsHandler(&handler))
+            handler.WriteAllFn(&g, &handler, &engine->UiSnapshotSettings);
+
+    engine->UiSnapshotWindows.Clear();
+    for (ImGuiWindow* window : g.Windows)
+        engine->UiSnapshotWindows.Data.push_back(ImGuiStorage::ImGuiStoragePair(window->ID, 1));
+    engine->UiSnapshotWindows.BuildSortByKey();
+    engine->UiSnapshotTables.Clear();
+    for (int n = 0; n < g.Tables.GetMapSize(); n++)
+        if (ImGuiTable* table = g.Tables.TryGetMapData(n))
+            engine->UiSnapshotTables.Data.push_back(ImGuiStorage::ImGuiStoragePair(table->ID, 1));
+    engine->UiSnapshotTables.BuildSortByKey();
+    engine->UiSnapshotValid = true;
+}
+
+// Restore state captured by ImGuiTestEngine_CaptureUiSnapshot(). This is meant to be cheap enough to be called before every test:
+// - Tables created since the snapshot are discarded (same as TableDiscardInstanceAndSettings()).
+// - Windows created since the snapshot are reset as if they were never submitted (so ImGuiCond_FirstUseEver/_Once apply again).
+// - Settings of windows, tables and dock nodes are cleared, reloaded from the snapshot and applied to existing windows/tables/dock nodes.
+// Windows using ImGuiWindowFlags_NoSavedSettings which existed at the time of the snapshot keep their current position/size.
+// Use ImGuiTestEngine_RebootUiContext() for a complete reset.
+void    ImGuiTestEngine_RestoreUiSnapshot(ImGuiTestEngine* engine)
+{
+    IM_ASSERT(engine->UiContextTarget != NULL && engine->UiSnapshotValid);
+    ImGuiContext& g = *engine->UiContextTarget;
+    IM_ASSERT(GImGui == &g);
+    IM_ASSERT(g.CurrentTable == NULL);
+    const ImU64 start_time = ImTimeGetInMicroseconds();
+
+    for (int n = 0; n < g.Tables.GetMapSize(); n++)
+        if (ImGuiTable* table = g.Tables.TryGetMapData(n))
+            if (!engine->UiSnapshotTables.GetBool(table->ID))
+                ImGui::TableRemove(table);
+
+    // Same initial state as set by ImGui::CreateNewWindow() for a window without settings
+    ImGuiViewport* main_viewport = ImGui::GetMainViewport();
+    for (ImGuiWindow* window : g.Windows)
+    {
+        if (engine->UiSnapshotWindows.GetBool(window->ID))
+            continue;
+        window->Pos = main_viewport->Pos + ImVec2(60, 60);
+        window->Size = window->SizeFull = ImVec2(0.0f, 0.0f);
+        window->Collapsed = false;
+        window->Scroll = ImVec2(0.0f, 0.0f);
+        window->ScrollTarget = ImVec2(FLT_MAX, FLT_MAX);
+        window->SetWindowPosAllowFlags = window->SetWindowSizeAllowFlags = window->SetWindowCollapsedAllowFlags = ImGuiCond_Always | ImGuiCond_Once | ImGuiCond_FirstUseEver | ImGuiCond_Appearing;
+        window->AutoFitFramesX = window->AutoFitFramesY = 2;
+        window->AutoFitOnlyGrows = false;
+    }
+
+    // Clear settings (this also clears all dock nodes) then reload them from the snapshot.
+    // Parsing is the same as ImGui::LoadIniSettingsFromMemory(), which we can't use as it would involve all other handlers.
+    for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+        if (ImGuiTestEngine_IsUiSnapshotSettingsHandler(&handler) && handler.ClearAllFn != NULL)
+            handler.ClearAllFn(&g, &handler);
+
+    ImVector<char>& buf = engine->UiSnapshotSettingsParseBuf;
+    buf.resize(engine->UiSnapshotSettings.size() + 1);
+    memcpy(buf.Data, engine->UiSnapshotSettings.c_str(), (size_t)buf.Size);
+    char* const buf_end = buf.Data + buf.Size - 1;
+    ImGuiSettingsHandler* entry_handler = NULL;
+    void* entry_data = NULL;
+    char* line_end = NULL;
+    for (char* line = buf.Data; line < buf_end; line = line_end + 1)
+    {
+        while (*line == '\n' || *line == '\r')
+            line++;
+        line_end = line;
+        while (line_end < buf_end && *line_end != '\n' && *line_end != '\r')
+            line_end++;
+        line_end[0] = 0;
+        if (line[0] == '[' && line_end > line && line_end[-1] == ']')
+        {
+            // Parse "[Type][Name]"
+            line_end[-1] = 0;
+            char* type_end = (char*)(void*)ImStrchrRange(line + 1, line_end - 1, ']');
+            const char* name_start = type_end ? ImStrchrRange(type_end + 1, line_end - 1, '[') : NULL;
+            entry_handler = NULL;
+            entry_data = NULL;
+            if (type_end == NULL || name_start == NULL)
+                continue;
+            *type_end = 0;
+            entry_handler = ImGui::FindSettingsHandler(line + 1);
+            entry_data = entry_handler ? entry_handler->ReadOpenFn(&g, entry_handler, name_start + 1) : NULL;
+        }
+        else if (entry_handler != NULL && entry_data != NULL)
+        {
+            entry_handler->ReadLineFn(&g, entry_handler, entry_data, line);
+        }
+    }
+
+    // Apply in handlers order: windows get their DockId before dock nodes are rebuilt
+    for (ImGuiSettingsHandler& handler : g.SettingsHandlers)
+        if (ImGuiTestEngine_IsUiSnapshotSettingsHandler(&handler) && handler.ApplyAllFn != NULL)
+            handler.ApplyAllFn(&g, &handler);
+
+    engine->UiSnapshotRestoreCount++;
+    engine->UiSnapshotRestoreTime += ImTimeGetInMicroseconds() - start_time;
+}
+
 void    ImGuiTestEngine_PostSwap(ImGuiTestEngine* engine)
 {
     engine->PostSwapCalled = true;
@@ -432,16 +572,96 @@ bool    ImGuiTestEngine_TryAbortEngine(ImGuiTestEngine* engine)
     return false; // Still running coroutine
 }
 
-// FIXME-OPT
+ImGuiTestInfoTask* ImGuiTestInfoTaskPool::Alloc()
+{
+    if (FreeList.Size == 0)
+    {
+        ImGuiTestInfoTask* block = (ImGuiTestInfoTask*)IM_ALLOC(sizeof(ImGuiTestInfoTask) * BlockSize);
+        Blocks.push_back(block);
+        FreeList.reserve(Blocks.Size * BlockSize);
+        for (int n = BlockSize - 1; n >= 0; n--)
+            FreeList.push_back(&block[n]);
+        HeapAllocCount++;
+    }
+    ImGuiTestInfoTask* task = FreeList.back();
+    FreeList.pop_back();
+    AliveCount++;
+    return IM_PLACEMENT_NEW(task) ImGuiTestInfoTask();
+}
+
+void ImGuiTestInfoTaskPool::Free(ImGuiTestInfoTask* task)
+{
+    IM_ASSERT(AliveCount > 0);
+    task->~ImGuiTestInfoTask();
+    FreeList.push_back(task);
+    AliveCount--;
+}
+
+// Release all blocks. Any task still alive is discarded.
+void ImGuiTestInfoTaskPool::Clear()
+{
+    for (ImGuiTestInfoTask* block : Blocks)
+        IM_FREE(block);
+    Blocks.clear();
+    FreeList.clear();
+    AliveCount = 0;
+}
+
+// Info tasks are looked up from ImGuiTestEngineHook_ItemAdd()/ImGuiTestEngineHook_ItemInfo() for every submitted item,
+// so we maintain an open-addressing index keyed by ID. IDs are already hashes so we use their low bits as-is.
+// The index is kept at <= 50% load so probing always terminates on an empty slot.
+// A small bloom filter sits in front of it: for the vast majority of items nobody asked about, rejection is two bit tests.
+static inline void ImGuiTestEngine_AddInfoTaskFilter(ImGuiTestEngine* engine, ImGuiID id)
+{
+    engine->InfoTasksFilter[(id >> 5) & 127] |= 1u << (id & 31);
+    engine->InfoTasksFilter[(id >> 17) & 127] |= 1u << ((id >> 12) & 31);
+}
+
+static inline bool ImGuiTestEngine_PassInfoTaskFilter(const ImGuiTestEngine* engine, ImGuiID id)
+{
+    if (!engine->IO.ConfigInfoTasksFilter)
+        return true;
+    return (engine->InfoTasksFilter[(id >> 5) & 127] & (1u << (id & 31))) != 0
+        && (engine->InfoTasksFilter[(id >> 17) & 127] & (1u << ((id >> 12) & 31))) != 0;
+}
+
+static void ImGuiTestEngine_InsertInfoTaskIndex(ImGuiTestEngine* engine, ImGuiTestInfoTask* task)
+{
+    ImGuiTestEngine_AddInfoTaskFilter(engine, task->ID);
+    const ImU32 mask = (ImU32)engine->InfoTasksIndex.Size - 1;
+    for (ImU32 slot = task->ID & mask; ; slot = (slot + 1) & mask)
+        if (engine->InfoTasksIndex[slot] == NULL)
+        {
+            engine->InfoTasksIndex[slot] = task;
+            return;
+        }
+}
+
+static void ImGuiTestEngine_RebuildInfoTasksIndex(ImGuiTestEngine* engine)
+{
+    int index_size = 16;
+    while (index_size < engine->InfoTasks.Size * 2)
+        index_size *= 2;
+    engine->InfoTasksIndex.resize(index_size);
+    memset(engine->InfoTasksIndex.Data, 0, (size_t)index_size * sizeof(ImGuiTestInfoTask*));
+    memset(engine->InfoTasksFilter, 0, sizeof(engine->InfoTasksFilter));
+    for (ImGuiTestInfoTask* task : engine->InfoTasks)
+        ImGuiTestEngine_InsertInfoTaskIndex(engine, task);
+}
+
 static ImGuiTestInfoTask* ImGuiTestEngine_FindInfoTask(ImGuiTestEngine* engine, ImGuiID id)
 {
-    for (int task_n = 0; task_n < engine->InfoTasks.Size; task_n++)
+    if (engine->InfoTasksIndex.Size == 0 || !ImGuiTestEngine_PassInfoTaskFilter(engine, id))
+        return NULL;
+    const ImU32 mask = (ImU32)engine->InfoTasksIndex.Size - 1;
+    for (ImU32 slot = id & mask; ; slot = (slot + 1) & mask)
     {
-        ImGuiTestInfoTask* task = engine->InfoTasks[task_n];
+        ImGuiTestInfoTask* task = engine->InfoTasksIndex[slot];
+        if (task == NULL)
+            return NULL;
         if (task->ID == id)
             return task;
     }
-    return NULL;
 }
 
 // Request information about one item.
@@ -462,7 +682,7 @@ ImGuiTestItemInfo* ImGuiTestEngine_FindItemInfo(ImGuiTestEngine* engine, ImGuiID
     }
 
     // Create task
-    ImGuiTestInfoTask* task = IM_NEW(ImGuiTestInfoTask)();
+    ImGuiTestInfoTask* task = engine->InfoTasksPool.Alloc();
     task->ID = id;
     task->FrameCount = engine->FrameCount;
     if (debug_id)
@@ -481,10 +701,32 @@ ImGuiTestItemInfo* ImGuiTestEngine_FindItemInfo(ImGuiTestEngine* engine, ImGuiID
         }
     }
     engine->InfoTasks.push_back(task);
+    if (engine->InfoTasks.Size * 2 > engine->InfoTasksIndex.Size)
+        ImGuiTestEngine_RebuildInfoTasksIndex(engine);
+    else
+        ImGuiTestEngine_InsertInfoTaskIndex(engine, task);
 
     return NULL;
 }
 
+// Register a pending wildcard query. The task is owned by the caller and must stay valid until removed.
+// Tasks are indexed by the hash of their last label, so ImGuiTestEngineHook_ItemInfo() can reject most labels with a single bit test.
+void ImGuiTestEngine_AddFindByLabelTask(ImGuiTestEngine* engine, ImGuiTestFindByLabelTask* task)
+{
+    IM_ASSERT(task->InSuffixLastItem != NULL);
+    const ImGuiID hash = task->InSuffixLastItemHash;
+    engine->FindByLabelTasks.push_back(task);
+    engine->FindByLabelTasksFilter[(hash >> 5) & 7] |= 1u << (hash & 31);
+}
+
+void ImGuiTestEngine_RemoveFindByLabelTask(ImGuiTestEngine* engine, ImGuiTestFindByLabelTask* task)
+{
+    engine->FindByLabelTasks.find_erase_unsorted(task);
+    memset(engine->FindByLabelTasksFilter, 0, sizeof(engine->FindByLabelTasksFilter));
+    for (ImGuiTestFindByLabelTask* other_task : engine->FindByLabelTasks)
+        engine->FindByLabelTasksFilter[(other_task->InSuffixLastItemHash >> 5) & 7] |= 1u << (other_task->InSuffixLastItemHash & 31);
+}
+
 static void ImGuiTestEngine_ClearTests(ImGuiTestEngine* engine)
 {
     for (int n = 0; n < engine->TestsAll.Size; n++)
@@ -680,8 +922,20 @@ static void ImGuiTestEngine_PreNewFrame(ImGuiTestEngine* engine, ImGuiContext* u
         engine->ToolDebugRebootUiContext = false;
     }
 
+    // Backup delta time provided by application, for turbo frames
+    if (!engine->TurboFramesRunning)
+        engine->TurboFramesDeltaTime = ui_ctx->IO.DeltaTime;
+
     // Inject extra time into the Dear ImGui context
-    if (engine->OverrideDeltaTime >= 0.0f)
+    // Time added by the virtual clock replaces the frame delta time entirely, so sleeping advances time by the same amount on every machine.
+    const float extra_time = engine->ExtraTime;
+    if (extra_time > 0.0f)
+    {
+        ui_ctx->IO.DeltaTime = extra_time;
+        engine->ExtraTime = 0.0f;
+        engine->OverrideDeltaTime = -1.0f;
+    }
+    else if (engine->OverrideDeltaTime >= 0.0f)
     {
         ui_ctx->IO.DeltaTime = engine->OverrideDeltaTime;
         engine->OverrideDeltaTime = -1.0f;
@@ -692,15 +946,18 @@ static void ImGuiTestEngine_PreNewFrame(ImGuiTestEngine* engine, ImGuiContext* u
     if (ImGuiTestContext* test_ctx = engine->TestContext)
     {
         double t0 = test_ctx->RunningTime;
-        double t1 = t0 + ui_ctx->IO.DeltaTime;
+        double t1 = t0 + ((extra_time > 0.0f) ? 0.0f : ui_ctx->IO.DeltaTime); // Virtual time doesn't count toward watchdog
         test_ctx->FrameCount++;
         test_ctx->RunningTime = t1;
         ImGuiTestEngine_UpdateWatchdog(engine, ui_ctx, t0, t1);
     }
 
-    engine->PerfDeltaTime100.AddSample(g.IO.DeltaTime);
-    engine->PerfDeltaTime500.AddSample(g.IO.DeltaTime);
-    engine->PerfDeltaTime1000.AddSample(g.IO.DeltaTime);
+    if (extra_time <= 0.0f)
+    {
+        engine->PerfDeltaTime100.AddSample(g.IO.DeltaTime);
+        engine->PerfDeltaTime500.AddSample(g.IO.DeltaTime);
+        engine->PerfDeltaTime1000.AddSample(g.IO.DeltaTime);
+    }
 
     if (!ImGuiTestEngine_IsTestQueueEmpty(engine) && !engine->Abort)
     {
@@ -742,17 +999,23 @@ static void ImGuiTestEngine_PostNewFrame(ImGuiTestEngine* engine, ImGuiContext*
     engine->IO.IsCapturing = engine->CaptureContext.IsCapturing();
 
     // Garbage collect unused tasks
+    // (with open-addressing we can't simply clear slots, so the index is rebuilt whenever tasks were removed)
     const int LOCATION_TASK_ELAPSE_FRAMES = 20;
+    bool info_tasks_removed = false;
     for (int task_n = 0; task_n < engine->InfoTasks.Size; task_n++)
     {
         ImGuiTestInfoTask* task = engine->InfoTasks[task_n];
         if (task->FrameCount < engine->FrameCount - LOCATION_TASK_ELAPSE_FRAMES && task->Result.RefCount == 0)
         {
-            IM_DELETE(task);
-            engine->InfoTasks.erase(engine->InfoTasks.Data + task_n);
+            engine->InfoTasksPool.Free(task);
+            engine->InfoTasks[task_n] = engine->InfoTasks.back(); // Swap-remove, order doesn't matter
+            engine->InfoTasks.pop_back();
             task_n--;
+            info_tasks_removed = true;
         }
     }
+    if (info_tasks_removed)
+        ImGuiTestEngine_RebuildInfoTasksIndex(engine);
 
     // Slow down whole app
     if (engine->ToolSlowDown)
@@ -765,8 +1028,12 @@ static void ImGuiTestEngine_PostNewFrame(ImGuiTestEngine* engine, ImGuiContext*
     // Run the test coroutine. This will resume the test queue from either the last point the test called YieldFromCoroutine(),
     // or the loop in ImGuiTestEngine_TestQueueCoroutineMain that does so if no test is running.
     // If you want to breakpoint the point execution continues in the test code, breakpoint the exit condition in YieldFromCoroutine()
+    // (coroutines may share our thread, e.g. when an engine is run from another engine's test: rebind the current engine around them)
     const int input_queue_size_before = ui_ctx->InputEventsQueue.Size;
+    ImGuiTestEngine* backup_current_engine = GImGuiTestEngineCurrentThread;
+    GImGuiTestEngineCurrentThread = engine;
     engine->IO.CoroutineFuncs->RunFunc(engine->TestQueueCoroutine);
+    GImGuiTestEngineCurrentThread = backup_current_engine;
 
     // Events added by TestFunc() marked automaticaly to not be deleted
     if (engine->TestContext && (engine->TestContext->RunFlags & ImGuiTestRunFlags_EnableRawInputs))
@@ -781,6 +1048,59 @@ static void ImGuiTestEngine_PostNewFrame(ImGuiTestEngine* engine, ImGuiContext*
     if (engine->IO.ConfigRunSpeed == ImGuiTestRunSpeed_Fast && engine->IO.IsRunningTests)
         if (engine->TestContext && (engine->TestContext->RunFlags & ImGuiTestRunFlags_GuiFuncOnly) == 0)
             engine->IO.IsRequestingMaxAppSpeed = true;
+
+    // Let application skip rendering
+    engine->IO.IsRequestingRender = ImGuiTestEngine_IsRenderNeeded(engine, ui_ctx);
+
+    // Run extra frames without going through the application loop
+    if (engine->IO.ConfigTurboFrames > 0 && !engine->TurboFramesRunning)
+        ImGuiTestEngine_RunTurboFrames(engine, ui_ctx);
+}
+
+// Draw data is only needed when running tests interactively, capturing, measuring performances, or for tests which explicitly require it.
+static bool ImGuiTestEngine_IsRenderNeeded(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
+{
+    ImGuiTestContext* test_ctx = engine->TestContext;
+    if (engine->IO.ConfigRunSpeed != ImGuiTestRunSpeed_Fast || !engine->IO.IsRunningTests || engine->Abort)
+        return true;
+    if (test_ctx == NULL || test_ctx->Test->Group == ImGuiTestGroup_Perfs || (test_ctx->Test->Flags & ImGuiTestFlags_RequireRender) || (test_ctx->RunFlags & ImGuiTestRunFlags_GuiFuncOnly))
+        return true;
+    if (engine->CaptureCurrentArgs != NULL || engine->CaptureContext.IsCapturing())
+        return true;
+#ifdef IMGUI_HAS_VIEWPORT
+    if (ui_ctx->IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable) // Platform windows are only updated by the application after Render()
+        return true;
+#else
+    IM_UNUSED(ui_ctx);
+#endif
+    return false;
+}
+
+// Extra frames are never rendered, so only run them when rendering isn't needed.
+static bool ImGuiTestEngine_CanRunTurboFrame(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
+{
+    if (engine->ToolDebugRebootUiContext || engine->ToolSlowDown)
+        return false;
+    return !ImGuiTestEngine_IsRenderNeeded(engine, ui_ctx);
+}
+
+// Run up to IO.ConfigTurboFrames frames (EndFrame + NewFrame, no Render) from within the application frame.
+// Each nested NewFrame() goes through ImGuiTestEngine_PreNewFrame()/ImGuiTestEngine_PostNewFrame() and therefore runs GuiFunc and resumes the test coroutine.
+// IO.TurboAppGuiFunc is called before each EndFrame() so windows submitted by the application keep being submitted every frame
+// (the application submits them itself for the last frame, after ImGui::NewFrame() returns).
+static void ImGuiTestEngine_RunTurboFrames(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
+{
+    engine->TurboFramesRunning = true;
+    for (int n = 0; n < engine->IO.ConfigTurboFrames && ImGuiTestEngine_CanRunTurboFrame(engine, ui_ctx); n++)
+    {
+        if (engine->IO.TurboAppGuiFunc != NULL)
+            engine->IO.TurboAppGuiFunc(engine->IO.TurboAppGuiUserData);
+        ImGui::EndFrame();
+        ui_ctx->IO.DeltaTime = engine->TurboFramesDeltaTime; // Don't carry over time injected in previous frame
+        ImGui::NewFrame();
+        engine->TurboFrameCount++;
+    }
+    engine->TurboFramesRunning = false;
 }
 
 static void ImGuiTestEngine_PreRender(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
@@ -834,11 +1154,23 @@ static void ImGuiTestEngine_RunGuiFunc(ImGuiTestEngine* engine)
 static void ImGuiTestEngine_TestQueueCoroutineMain(void* engine_opaque)
 {
     ImGuiTestEngine* engine = (ImGuiTestEngine*)engine_opaque;
+
+    // The coroutine may run on its own thread: bind it to our contexts and engine in case GImGui/GImPlot are thread-local.
+    // (we are resumed from our context's PostNewFrame hook, so in the common case of globals this is a no-op)
+    ImGui::SetCurrentContext(engine->UiContextTarget);
+#if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
+    ImPlot::SetCurrentContext(engine->PlotContext);
+#endif
+    GImGuiTestEngineCurrentThread = engine;
+
     while (!engine->TestQueueCoroutineShouldExit)
     {
         ImGuiTestEngine_ProcessTestQueue(engine);
         engine->IO.CoroutineFuncs->YieldFunc();
     }
+
+    if (GImGuiTestEngineCurrentThread == engine)
+        GImGuiTestEngineCurrentThread = NULL;
 }
 
 static void ImGuiTestEngine_DisableWindowInputs(ImGuiWindow* window)
@@ -873,6 +1205,13 @@ void ImGuiTestEngine_SetDeltaTime(ImGuiTestEngine* engine, float delta_time)
     engine->OverrideDeltaTime = delta_time;
 }
 
+// Advance the virtual clock: next frame will have a delta time equal to the time accumulated since last frame.
+void ImGuiTestEngine_AddExtraTime(ImGuiTestEngine* engine, float extra_time)
+{
+    IM_ASSERT(extra_time >= 0.0f);
+    engine->ExtraTime += extra_time;
+}
+
 int ImGuiTestEngine_GetFrameCount(ImGuiTestEngine* engine)
 {
     return engine->FrameCount;
@@ -961,6 +1300,7 @@ bool ImGuiTestEngine_CaptureBeginVideo(ImGuiTestEngine* engine, ImGuiCaptureArgs
     // RunSpeed set to Cinematic -> No change
     engine->BackupConfigRunSpeed = engine->IO.ConfigRunSpeed;
     engine->BackupConfigNoThrottle = engine->IO.ConfigNoThrottle;
+    engine->BackupConfigFixedDeltaTime = engine->IO.ConfigFixedDeltaTime;
     if (engine->IO.ConfigRunSpeed == ImGuiTestRunSpeed_Fast)
     {
         engine->IO.ConfigRunSpeed = ImGuiTestRunSpeed_Cinematic;
@@ -982,7 +1322,7 @@ bool ImGuiTestEngine_CaptureEndVideo(ImGuiTestEngine* engine, ImGuiCaptureArgs*
         ImGuiTestEngine_Yield(engine);
     engine->IO.ConfigRunSpeed = engine->BackupConfigRunSpeed;
     engine->IO.ConfigNoThrottle = engine->BackupConfigNoThrottle;
-    engine->IO.ConfigFixedDeltaTime = 0;
+    engine->IO.ConfigFixedDeltaTime = engine->BackupConfigFixedDeltaTime;
     engine->CaptureCurrentArgs = NULL;
     return true;
 }
@@ -996,6 +1336,12 @@ static void ImGuiTestEngine_ProcessTestQueue(ImGuiTestEngine* engine)
     io.IniFilename = NULL;
 
     engine->StartTime = ImTimeGetInMicroseconds();
+    engine->StartFrameCount = engine->FrameCount;
+    engine->TurboFrameCount = 0;
+    engine->UiSnapshotRestoreCount = 0;
+    engine->UiSnapshotRestoreTime = 0;
+    if (engine->IO.ConfigRestoreUiSnapshot)
+        ImGuiTestEngine_CaptureUiSnapshot(engine);
     int ran_tests = 0;
     engine->IO.IsRunningTests = true;
     for (int n = 0; n < engine->TestsQueue.Size; n++)
@@ -1025,7 +1371,6 @@ static void ImGuiTestEngine_ProcessTestQueue(ImGuiTestEngine* engine)
         ctx.Engine = engine;
         ctx.EngineIO = &engine->IO;
         ctx.Inputs = &engine->Inputs;
-        ctx.GatherTask = &engine->GatherTask;
         ctx.UserVars = NULL;
         ctx.UiContext = engine->UiContextActive;
         ctx.PerfStressAmount = engine->IO.PerfStressAmount;
@@ -1071,6 +1416,7 @@ static void ImGuiTestEngine_ProcessTestQueue(ImGuiTestEngine* engine)
         }
         ran_tests++;
         test->EndTime = ImTimeGetInMicroseconds();
+        test->FrameCount = ctx.FrameCount;
 
         IM_ASSERT(engine->TestContext == &ctx);
         IM_ASSERT(engine->UiContextActive == engine->UiContextTarget);
@@ -1085,6 +1431,7 @@ static void ImGuiTestEngine_ProcessTestQueue(ImGuiTestEngine* engine)
     }
     engine->IO.IsRunningTests = false;
     engine->EndTime = ImTimeGetInMicroseconds();
+    engine->EndFrameCount = engine->FrameCount;
 
     engine->Abort = false;
     engine->TestsQueue.clear();
@@ -1159,6 +1506,7 @@ ImGuiPerfTool* ImGuiTestEngine_GetPerfTool(ImGuiTestEngine* engine)
 // - '-' prefix excludes tests matched by the term.
 // - '^' prefix anchors term matching to the start of the string.
 // - '$' suffix anchors term matching to the end of the string.
+// - '*' matches any number of characters, '?' matches any single character.
 // Example queries:
 // - ""      : empty query matches no tests.
 // - "all"   : all tests, no matter what group they are in.
@@ -1168,47 +1516,44 @@ ImGuiPerfTool* ImGuiTestEngine_GetPerfTool(ImGuiTestEngine* engine)
 // - "_nav$" : all tests with name ending with "_nav".
 // - "-xxx"  : all tests and perfs that do not contain "xxx".
 // - "tests,-scroll,-^nav_" : all tests (but no perfs) that do not contain "scroll" in their name and does not start with "nav_".
+// - "^nav_*_scroll$" : all tests with name starting with "nav_" and ending with "_scroll".
 // Note: while we borrowed ^ and $ from regex conventions, we do not support actual regex syntax except for behavior of these two modifiers.
-bool ImGuiTestEngine_PassFilter(ImGuiTest* test, const char* filter)
+static inline char ImGuiTestFilter_ToUpper(char c)
 {
-    IM_ASSERT(filter != NULL);
-    auto str_iequal = [](const char* s1, const char* s2, const char* s2_end)
-    {
-        size_t s2_len = (size_t)(s2_end - s2);
-        if (strlen(s1) != s2_len) return false;
-        return ImStrnicmp(s1, s2, s2_len) == 0;
-    };
+    return (c >= 'a' && c <= 'z') ? (char)(c - 'a' + 'A') : c;
+}
 
-    auto str_iendswith = [&str_iequal](const char* s1, const char* s2, const char* s2_end)
-    {
-        size_t s1_len = strlen(s1);
-        size_t s2_len = (size_t)(s2_end - s2);
-        if (s1_len < s2_len) return false;
-        s1 = s1 + s1_len - s2_len;
-        return str_iequal(s1, s2, s2_end);
-    };
+static bool ImGuiTestFilter_IsKeyword(const char* keyword, const char* s, const char* s_end)
+{
+    size_t s_len = (size_t)(s_end - s);
+    return strlen(keyword) == s_len && ImStrnicmp(keyword, s, s_len) == 0;
+}
 
-    bool include = false;
-    const char* prefixes = "^-";
+void ImGuiTestFilter::Compile(const char* filter)
+{
+    IM_ASSERT(filter != NULL);
+    Terms.resize(0);
+    Patterns.resize(0);
+    IncludeByDefault = false;
 
     // When filter starts with exclude condition, we assume we have included all tests from the start. This enables
     // writing "-window" instead of "all,-window".
+    const char* prefixes = "^-";
     for (int i = 0; filter[i]; i++)
         if (filter[i] == '-')
-            include = true; // First filter is exclusion
+            IncludeByDefault = true; // First filter is exclusion
         else if (strchr(prefixes, filter[i]) == NULL)
             break;          // End of prefixes
 
     for (const char* filter_start = filter; filter_start[0];)
     {
         // Filter modifiers
-        bool is_exclude = false;
+        ImGuiTestFilterTerm term;
         bool is_anchor_to_start = false;
-        bool is_anchor_to_end = false;
         for (;;)
         {
             if (filter_start[0] == '-')
-                is_exclude = true;
+                term.IsExclude = true;
             else if (filter_start[0] == '^')
                 is_anchor_to_start = true;
             else
@@ -1216,72 +1561,357 @@ bool ImGuiTestEngine_PassFilter(ImGuiTest* test, const char* filter)
             filter_start++;
         }
 
-        const char* filter_end = strstr(filter_start, ",");
+        const char* filter_end = strchr(filter_start, ',');
         filter_end = filter_end ? filter_end : filter_start + strlen(filter_start);
-        is_anchor_to_end = filter_end[-1] == '$';
+        const bool is_anchor_to_end = filter_end > filter_start && filter_end[-1] == '$';
         if (is_anchor_to_end)
             filter_end--;
 
-        if (str_iequal("all", filter_start, filter_end))
-            include = !is_exclude;
-        else if (str_iequal("tests", filter_start, filter_end))
-            include = (test->Group == ImGuiTestGroup_Tests) ? !is_exclude : include;
-        else if (str_iequal("perfs", filter_start, filter_end))
-            include = (test->Group == ImGuiTestGroup_Perfs) ? !is_exclude : include;
-        else if (!is_anchor_to_start && !is_anchor_to_end)
-            include = ImStristr(test->Name, NULL, filter_start, filter_end) != NULL ? !is_exclude : include;    // "foo" - match a substring.
-        else
+        if (filter_start < filter_end)
         {
-            bool match = true;
-            if (is_anchor_to_start)
-                match &= ImStrnicmp(test->Name, filter_start, filter_end - filter_start) == 0;                  // "^foo" - match start of the string.
-            if (is_anchor_to_end)
-                match &= str_iendswith(test->Name, filter_start, filter_end);                                   // "foo$" - match end of the string.
-            if (match)
-                include = !is_exclude;
+            bool is_glob = false;
+            for (const char* c = filter_start; c < filter_end; c++)
+                if (*c == '*' || *c == '?')
+                    is_glob = true;
+
+            if (ImGuiTestFilter_IsKeyword("all", filter_start, filter_end))
+                term.Type = ImGuiTestFilterTermType_All;
+            else if (ImGuiTestFilter_IsKeyword("tests", filter_start, filter_end))
+                { term.Type = ImGuiTestFilterTermType_Group; term.Group = ImGuiTestGroup_Tests; }
+            else if (ImGuiTestFilter_IsKeyword("perfs", filter_start, filter_end))
+                { term.Type = ImGuiTestFilterTermType_Group; term.Group = ImGuiTestGroup_Perfs; }
+            else if (is_glob)
+                term.Type = ImGuiTestFilterTermType_Glob;                   // "foo*bar" - match a pattern.
+            else if (is_anchor_to_start && is_anchor_to_end)
+                term.Type = ImGuiTestFilterTermType_Exact;                  // "^foo$" - match whole string.
+            else if (is_anchor_to_start)
+                term.Type = ImGuiTestFilterTermType_Prefix;                 // "^foo" - match start of the string.
+            else if (is_anchor_to_end)
+                term.Type = ImGuiTestFilterTermType_Suffix;                 // "foo$" - match end of the string.
+            else
+                term.Type = ImGuiTestFilterTermType_Substring;              // "foo" - match a substring.
+
+            // Store upper-cased pattern
+            if (term.Type != ImGuiTestFilterTermType_All && term.Type != ImGuiTestFilterTermType_Group)
+            {
+                term.PatternOffset = Patterns.Size;
+                if (term.Type == ImGuiTestFilterTermType_Glob && !is_anchor_to_start)
+                    Patterns.push_back('*');
+                for (const char* c = filter_start; c < filter_end; c++)
+                    Patterns.push_back(ImGuiTestFilter_ToUpper(*c));
+                if (term.Type == ImGuiTestFilterTermType_Glob && !is_anchor_to_end)
+                    Patterns.push_back('*');
+                term.PatternLen = Patterns.Size - term.PatternOffset;
+                Patterns.push_back(0);
+            }
+            Terms.push_back(term);
         }
 
         while (filter_end[0] == ',' || filter_end[0] == '$')
             filter_end++;
         filter_start = filter_end;
     }
-    return include;
+}
+
+// Case-insensitive match with '*' and '?' wildcards (pattern is upper-cased). Backtracks to the last '*' only, so this is linear for typical patterns.
+static bool ImGuiTestFilter_MatchGlob(const char* name, const char* pattern)
+{
+    const char* star_pattern = NULL;
+    const char* star_name = NULL;
+    while (*name)
+    {
+        if (*pattern == '*')
+        {
+            star_pattern = ++pattern;
+            star_name = name;
+        }
+        else if (*pattern != 0 && (*pattern == '?' || *pattern == ImGuiTestFilter_ToUpper(*name)))
+        {
+            pattern++;
+            name++;
+        }
+        else if (star_pattern != NULL)
+        {
+            pattern = star_pattern;
+            name = ++star_name;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    while (*pattern == '*')
+        pattern++;
+    return *pattern == 0;
+}
+
+static bool ImGuiTestFilter_MatchPrefix(const char* name, const char* pattern, int pattern_len)
+{
+    for (int n = 0; n < pattern_len; n++)
+        if (ImGuiTestFilter_ToUpper(name[n]) != pattern[n]) // Also stops on name zero-terminator
+            return false;
+    return true;
+}
+
+static bool ImGuiTestFilter_MatchSubstring(const char* name, int name_len, const char* pattern, int pattern_len)
+{
+    if (pattern_len > name_len)
+        return false;
+    const char first_c = pattern[0];
+    for (const char* name_last = name + name_len - pattern_len; name <= name_last; name++)
+        if (ImGuiTestFilter_ToUpper(*name) == first_c && ImGuiTestFilter_MatchPrefix(name + 1, pattern + 1, pattern_len - 1))
+            return true;
+    return false;
+}
+
+// The last matching term decides whether the test is included, so we iterate backward and early out on the first match.
+bool ImGuiTestFilter::PassFilter(const char* name, ImGuiTestGroup group) const
+{
+    int name_len = -1;
+    for (int term_n = Terms.Size - 1; term_n >= 0; term_n--)
+    {
+        const ImGuiTestFilterTerm& term = Terms[term_n];
+        const char* pattern = Patterns.Data + term.PatternOffset;
+        if (name_len == -1 && (term.Type == ImGuiTestFilterTermType_Substring || term.Type == ImGuiTestFilterTermType_Suffix || term.Type == ImGuiTestFilterTermType_Exact))
+            name_len = (int)strlen(name);
+
+        bool match = false;
+        switch (term.Type)
+        {
+        case ImGuiTestFilterTermType_All:       match = true; break;
+        case ImGuiTestFilterTermType_Group:     match = (group == term.Group); break;
+        case ImGuiTestFilterTermType_Substring: match = ImGuiTestFilter_MatchSubstring(name, name_len, pattern, term.PatternLen); break;
+        case ImGuiTestFilterTermType_Prefix:    match = ImGuiTestFilter_MatchPrefix(name, pattern, term.PatternLen); break;
+        case ImGuiTestFilterTermType_Suffix:    match = (name_len >= term.PatternLen) && ImGuiTestFilter_MatchPrefix(name + name_len - term.PatternLen, pattern, term.PatternLen); break;
+        case ImGuiTestFilterTermType_Exact:     match = (name_len == term.PatternLen) && ImGuiTestFilter_MatchPrefix(name, pattern, term.PatternLen); break;
+        case ImGuiTestFilterTermType_Glob:      match = ImGuiTestFilter_MatchGlob(name, pattern); break;
+        }
+        if (match)
+            return !term.IsExclude;
+    }
+    return IncludeByDefault;
+}
+
+bool ImGuiTestFilter::PassFilter(const ImGuiTest* test) const
+{
+    return PassFilter(test->Name, test->Group);
+}
+
+// Prefer compiling an ImGuiTestFilter once when matching many tests.
+bool ImGuiTestEngine_PassFilter(ImGuiTest* test, const char* filter)
+{
+    ImGuiTestFilter test_filter(filter);
+    return test_filter.PassFilter(test);
+}
+
+struct ImGuiTestShardEntry
+{
+    ImGuiTest*  Test;
+    ImU64       Duration;       // Expected duration (in microseconds)
+    int         Index;          // Index in list of matching tests
+    int         Shard;
+};
+
+static int IMGUI_CDECL ImGuiTestEngine_CompareShardEntriesByDuration(const void* lhs, const void* rhs)
+{
+    const ImGuiTestShardEntry* a = (const ImGuiTestShardEntry*)lhs;
+    const ImGuiTestShardEntry* b = (const ImGuiTestShardEntry*)rhs;
+    if (a->Duration != b->Duration)
+        return (a->Duration < b->Duration) ? +1 : -1;
+    return a->Index - b->Index;
+}
+
+// Only keep tests of shard io.ConfigShardIndex, out of io.ConfigShardCount shards of similar total duration.
+// Expected duration of each test is the one of its last run (ImGuiTest::StartTime/EndTime), tests which never ran are assumed to take the average duration.
+// Longest tests are assigned first to the shard with the lowest total so far (LPT scheduling). The result only depends on test list and durations,
+// so all processes/engines sharing the same durations agree on the partition.
+static void ImGuiTestEngine_SelectShard(ImGuiTestEngine* engine, ImVector<ImGuiTest*>* tests)
+{
+    const int shard_count = engine->IO.ConfigShardCount;
+    const int shard_index = engine->IO.ConfigShardIndex;
+    IM_ASSERT(shard_count > 1 && shard_index >= 0 && shard_index < shard_count);
+
+    ImVector<ImGuiTestShardEntry> entries;
+    entries.resize(tests->Size);
+    ImU64 known_duration_total = 0;
+    int known_duration_count = 0;
+    for (int n = 0; n < tests->Size; n++)
+    {
+        ImGuiTest* test = (*tests)[n];
+        ImGuiTestShardEntry& entry = entries[n];
+        entry.Test = test;
+        entry.Duration = (test->EndTime > test->StartTime) ? (test->EndTime - test->StartTime) : 0;
+        entry.Index = n;
+        entry.Shard = -1;
+        if (entry.Duration > 0)
+        {
+            known_duration_total += entry.Duration;
+            known_duration_count++;
+        }
+    }
+    const ImU64 default_duration = (known_duration_count > 0) ? ImMax(known_duration_total / known_duration_count, (ImU64)1) : 1;
+    for (ImGuiTestShardEntry& entry : entries)
+        if (entry.Duration == 0)
+            entry.Duration = default_duration;
+    ImQsort(entries.Data, (size_t)entries.Size, sizeof(ImGuiTestShardEntry), ImGuiTestEngine_CompareShardEntriesByDuration);
+
+    ImVector<ImU64> shard_durations;
+    shard_durations.resize(shard_count, 0);
+    for (ImGuiTestShardEntry& entry : entries)
+    {
+        int best_shard = 0;
+        for (int shard_n = 1; shard_n < shard_count; shard_n++)
+            if (shard_durations[shard_n] < shard_durations[best_shard])
+                best_shard = shard_n;
+        shard_durations[best_shard] += entry.Duration;
+        entry.Shard = best_shard;
+    }
+
+    // Keep tests of our shard, in their original order
+    ImVector<bool> keep;
+    keep.resize(tests->Size, false);
+    for (ImGuiTestShardEntry& entry : entries)
+        keep[entry.Index] = (entry.Shard == shard_index);
+    int dst_n = 0;
+    for (int n = 0; n < tests->Size; n++)
+        if (keep[n])
+            (*tests)[dst_n++] = (*tests)[n];
+    tests->resize(dst_n);
+}
+
+// Remove tests which passed in a run recorded in the result cache (see ImGuiTestEngine_LoadResultCache()) with same source and build hashes.
+// Nothing is skipped without IO.BuildId, as changes to the code under test would go unnoticed.
+static void ImGuiTestEngine_SkipUnchangedTests(ImGuiTestEngine* engine, ImVector<ImGuiTest*>* tests)
+{
+    if (engine->ResultCache.Size == 0 || engine->IO.BuildId[0] == 0)
+        return;
+    const ImGuiID build_hash = ImGuiTestEngine_CalcBuildHash(engine);
+    int dst_n = 0;
+    for (int n = 0; n < tests->Size; n++)
+    {
+        ImGuiTest* test = (*tests)[n];
+        const ImGuiTestResultCacheEntry* entry = ImGuiTestEngine_FindResultCacheEntry(engine, test);
+        if (entry && entry->Status == ImGuiTestStatus_Success && test->SourceHash != 0 && entry->SourceHash == test->SourceHash && entry->BuildHash == build_hash)
+            engine->ResultCacheSkippedCount++;
+        else
+            (*tests)[dst_n++] = test;
+    }
+    tests->resize(dst_n);
 }
 
 void ImGuiTestEngine_QueueTests(ImGuiTestEngine* engine, ImGuiTestGroup group, const char* filter_str, ImGuiTestRunFlags run_flags)
 {
     IM_ASSERT(group >= ImGuiTestGroup_Unknown && group < ImGuiTestGroup_COUNT);
+    ImGuiTestFilter filter(filter_str);
+    ImVector<ImGuiTest*> tests;
     for (int n = 0; n < engine->TestsAll.Size; n++)
     {
         ImGuiTest* test = engine->TestsAll[n];
         if (group != ImGuiTestGroup_Unknown && test->Group != group)
             continue;
 
-        if (!ImGuiTestEngine_PassFilter(test, filter_str))
+        if (!filter.PassFilter(test))
             continue;
 
-        ImGuiTestEngine_QueueTest(engine, test, run_flags);
+        tests.push_back(test);
     }
+
+    if (engine->IO.ConfigQueueChangedOnly)
+        ImGuiTestEngine_SkipUnchangedTests(engine, &tests);
+    if (engine->IO.ConfigShardCount > 1)
+        ImGuiTestEngine_SelectShard(engine, &tests);
+
+    for (ImGuiTest* test : tests)
+        ImGuiTestEngine_QueueTest(engine, test, run_flags);
 }
 
-static void ImGuiTestEngine_StartCalcSourceLineEnds(ImGuiTestEngine* engine)
+static bool ImGuiTestEngine_IsSameSourceFile(const ImGuiTest* a, const ImGuiTest* b)
+{
+    if (a->SourceFile == b->SourceFile)
+        return true;
+    return a->SourceFile && b->SourceFile && strcmp(a->SourceFile, b->SourceFile) == 0;
+}
+
+static int IMGUI_CDECL ImGuiTestEngine_CompareTestsBySource(const void* lhs, const void* rhs)
+{
+    const ImGuiTest* a = *(const ImGuiTest* const*)lhs;
+    const ImGuiTest* b = *(const ImGuiTest* const*)rhs;
+    if (a->SourceFile != b->SourceFile)
+        if (int d = strcmp(a->SourceFile ? a->SourceFile : "", b->SourceFile ? b->SourceFile : ""))
+            return d;
+    return (a->SourceLine > b->SourceLine) - (a->SourceLine < b->SourceLine);
+}
+
+// Set SourceLineEnd of each test to the line of the next test registered in the same source file.
+// Sort tests by (SourceFile, SourceLine) then assign in a single pass. Last test of each file keeps SourceLineEnd == SourceLine.
+void ImGuiTestEngine_CalcSourceLineEnds(ImGuiTestEngine* engine)
 {
     if (engine->TestsAll.empty())
         return;
 
-    ImVector<int> line_starts;
-    line_starts.reserve(engine->TestsAll.Size);
-    for (int n = 0; n < engine->TestsAll.Size; n++)
-        line_starts.push_back(engine->TestsAll[n]->SourceLine);
-    ImQsort(line_starts.Data, (size_t)line_starts.Size, sizeof(int), [](const void* lhs, const void* rhs) { return (*(const int*)lhs) - *(const int*)rhs; });
+    ImVector<ImGuiTest*> tests = engine->TestsAll;
+    ImQsort(tests.Data, (size_t)tests.Size, sizeof(ImGuiTest*), ImGuiTestEngine_CompareTestsBySource);
 
-    for (int n = 0; n < engine->TestsAll.Size; n++)
+    for (int n = 0; n < tests.Size;)
     {
-        ImGuiTest* test = engine->TestsAll[n];
-        for (int m = 0; m < line_starts.Size - 1; m++) // FIXME-OPT
-            if (line_starts[m] == test->SourceLine)
-                test->SourceLineEnd = ImMax(test->SourceLine, line_starts[m + 1]);
+        // Tests registered from the same line (e.g. in a loop) share the same end
+        int next_n = n + 1;
+        while (next_n < tests.Size && tests[next_n]->SourceLine == tests[n]->SourceLine && ImGuiTestEngine_IsSameSourceFile(tests[n], tests[next_n]))
+            next_n++;
+        const int line_end = (next_n < tests.Size && ImGuiTestEngine_IsSameSourceFile(tests[n], tests[next_n])) ? tests[next_n]->SourceLine : tests[n]->SourceLine;
+        for (int m = n; m < next_n; m++)
+            tests[m]->SourceLineEnd = line_end;
+        n = next_n;
+    }
+}
+
+// Set SourceHash of each test to the hash of its source lines: from SourceLine to SourceLineEnd (excluded), or up to the end of file for the last test of a file.
+// Line endings are not hashed, so a file checked out with CRLF or LF line endings gives the same hashes. Tests of unreadable source files get SourceHash == 0.
+// This only covers the test own code: changes to shared helpers or to dear imgui itself are not detected (see ImGuiTestEngine_CalcBuildHash()).
+void ImGuiTestEngine_CalcSourceHashes(ImGuiTestEngine* engine)
+{
+    ImGuiTestEngine_CalcSourceLineEnds(engine);
+
+    ImVector<ImGuiTest*> tests = engine->TestsAll;
+    ImQsort(tests.Data, (size_t)tests.Size, sizeof(ImGuiTest*), ImGuiTestEngine_CompareTestsBySource);
+
+    char* file_data = NULL;
+    size_t file_size = 0;
+    ImVector<const char*> line_starts;  // line_starts[N] = start of line N+1
+    for (int n = 0; n < tests.Size; n++)
+    {
+        ImGuiTest* test = tests[n];
+        if (n == 0 || !ImGuiTestEngine_IsSameSourceFile(tests[n - 1], test))
+        {
+            IM_FREE(file_data);
+            file_data = test->SourceFile ? (char*)ImFileLoadToMemory(test->SourceFile, "rb", &file_size) : NULL;
+            line_starts.resize(0);
+            if (file_data != NULL)
+            {
+                line_starts.push_back(file_data);
+                for (const char* p = file_data; p < file_data + file_size; p++)
+                    if (*p == '\n')
+                        line_starts.push_back(p + 1);
+            }
+        }
+
+        test->SourceHash = 0;
+        if (file_data == NULL || test->SourceLine < 1 || test->SourceLine > line_starts.Size)
+            continue;
+        const int line_n_end = (test->SourceLineEnd > test->SourceLine) ? ImMin(test->SourceLineEnd, line_starts.Size + 1) : line_starts.Size + 1;
+        ImGuiID hash = 0;
+        for (int line_n = test->SourceLine; line_n < line_n_end; line_n++)
+        {
+            const char* line = line_starts[line_n - 1];
+            const char* line_end = (line_n < line_starts.Size) ? line_starts[line_n] : file_data + file_size;
+            while (line_end > line && (line_end[-1] == '\n' || line_end[-1] == '\r'))
+                line_end--;
+            hash = ImHashData(line, (size_t)(line_end - line), hash);
+        }
+        test->SourceHash = (hash != 0) ? hash : 1;
     }
+    IM_FREE(file_data);
+    engine->SourceHashesValid = true;
 }
 
 void ImGuiTestEngine_GetResult(ImGuiTestEngine* engine, int& count_tested, int& count_success)
@@ -1301,6 +1931,14 @@ void ImGuiTestEngine_GetResult(ImGuiTestEngine* engine, int& count_tested, int&
     }
 }
 
+// Registered tests, in registration order.
+// (order is deterministic, so an index into this list identifies the same test in other engines running the same registration code)
+void ImGuiTestEngine_GetTestList(ImGuiTestEngine* engine, ImVector<ImGuiTest*>* out_tests)
+{
+    IM_ASSERT(out_tests != NULL);
+    *out_tests = engine->TestsAll;
+}
+
 static void ImGuiTestEngine_UpdateHooks(ImGuiTestEngine* engine)
 {
     ImGuiContext* ui_ctx = engine->UiContextTarget;
@@ -1312,9 +1950,9 @@ static void ImGuiTestEngine_UpdateHooks(ImGuiTestEngine* engine)
 
     if (engine->InfoTasks.Size > 0)
         want_hooking = true;
-    if (engine->FindByLabelTask.InSuffix != NULL)
+    if (engine->FindByLabelTasks.Size > 0)
         want_hooking = true;
-    if (engine->GatherTask.InParentID != 0)
+    if (engine->GatherTasksCount > 0)
         want_hooking = true;
 
     // Update test engine specific hooks
@@ -1326,6 +1964,10 @@ static void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* c
     // Clear ImGui inputs to avoid key/mouse leaks from one test to another
     ImGuiTestEngine_ClearInput(engine);
 
+    // Restore UI context snapshot to avoid windows/tables/dock nodes state leaks from one test to another
+    if (engine->IO.ConfigRestoreUiSnapshot && engine->UiSnapshotValid)
+        ImGuiTestEngine_RestoreUiSnapshot(engine);
+
     ImGuiTest* test = ctx->Test;
     ctx->FrameCount = 0;
     ctx->ErrorCounter = 0;
@@ -1404,6 +2046,18 @@ static void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* c
         {
             // Test function
             test->TestFunc(ctx);
+            if (ctx->RefCacheHits + ctx->RefCacheMisses > 0)
+                ctx->LogDebug("Ref cache: %d hits, %d misses (%.1f%% hit rate)", ctx->RefCacheHits, ctx->RefCacheMisses, ctx->RefCacheHits * 100.0f / (ctx->RefCacheHits + ctx->RefCacheMisses));
+
+            // In case test failed between GatherItemsBegin() and GatherItemsEnd() - drop the tasks here, as their output
+            // lists lived on the TestFunc() stack. This may trigger due to a failed IM_CHECK() or IM_SUSPEND_TESTFUNC().
+            if (engine->GatherTasksCount > 0)
+            {
+                for (int task_n = 0; task_n < engine->GatherTasksCount; task_n++)
+                    engine->GatherTasks[task_n] = ImGuiTestGatherTask();
+                engine->GatherTasksCount = 0;
+                ctx->LogWarning("Recovered from missing GatherItemsEnd()");
+            }
 
             // In case test failed without finishing gif capture - finish it here. This may trigger due to user error or
             // due to IM_SUSPEND_TESTFUNC() terminating TestFunc() early.
@@ -1581,19 +2235,95 @@ void ImGuiTestEngine_InstallDefaultCrashHandler()
 // - ImGuiTestEngineHook_AssertFunc()
 //-------------------------------------------------------------------------
 
+// Test for matching PREFIX (the "window" of "window/**/foo/bar" or the "" of "/**/foo/bar")
+// FIXME-TESTS: Stack depth limit?
+// FIXME-TESTS: Recurse back into parent window limit?
+static bool ImGuiTestEngine_FindByLabelMatchPrefix(ImGuiContext* ui_ctx, const ImGuiTestFindByLabelTask* label_task)
+{
+    if (label_task->InPrefixId == 0)
+        return true;
+    for (ImGuiWindow* window = ui_ctx->CurrentWindow; window != NULL; window = window->ParentWindow)
+    {
+        const int id_stack_size = window->IDStack.Size;
+        for (ImGuiID* p_id_stack = window->IDStack.Data + id_stack_size - 1; p_id_stack >= window->IDStack.Data; p_id_stack--)
+            if (*p_id_stack == label_task->InPrefixId)
+                return true;
+    }
+    return false;
+}
+
+// Test for full matching SUFFIX (the "foo/bar" or "window/**/foo/bar")
+// FIXME-TESTS: The entire suffix must be inside the final window.
+// In theory, someone could craft a suffix that contains sub-window, e.g. "SomeWindow/**/SomeChild_XXXX/SomeItem" and this will fail.
+static bool ImGuiTestEngine_FindByLabelMatchSuffix(ImGuiContext* ui_ctx, const ImGuiTestFindByLabelTask* label_task, ImGuiID id)
+{
+    ImGuiWindow* window = ui_ctx->CurrentWindow;
+    const int id_stack_size = window->IDStack.Size;
+    const int id_stack_pos = id_stack_size - label_task->InSuffixDepth;
+    ImGuiID base_id = id_stack_pos >= 0 ? window->IDStack.Data[id_stack_pos] : 0;   // base_id correspond to the "**"
+    ImGuiID find_id = ImHashDecoratedPath(label_task->InSuffix, NULL, base_id);     // essentially compare the whole "foo/bar" suffix.
+    return id == find_id;
+}
+
+// Called for every item while a wildcard query ("**/foo/bar") couldn't be resolved from visible items.
+// - Items clipped by their window never call ImGuiTestEngineHook_ItemInfo() so we don't know their label,
+//   but we can still compare their ID with the hash of the suffix based on current ID stack.
+// - Items skipped by a ImGuiListClipper are not submitted at all: while a clipper is measuring its first item
+//   (before it calculates its visible range), we request it to display its full range for this frame.
+//   This is only done for clippers inside the searched window (known prefix), never for every clipper on screen.
+static void ImGuiTestEngineHook_ItemAdd_FindByLabelClipped(ImGuiContext* ui_ctx, const ImRect& bb, ImGuiID id)
+{
+    ImGuiContext& g = *ui_ctx;
+    ImGuiTestEngine* engine = (ImGuiTestEngine*)ui_ctx->TestEngine;
+
+#if IMGUI_VERSION_NUM >= 18509
+    if (g.ClipperTempDataStacked > 0)
+    {
+        ImGuiListClipper* clipper = g.ClipperTempData[g.ClipperTempDataStacked - 1].ListClipper;
+        if (clipper->ItemsHeight <= 0.0f && clipper->ItemsCount > 0)
+            for (ImGuiTestFindByLabelTask* label_task : engine->FindByLabelTasks)
+                if (label_task->OutItemId == 0 && label_task->InPrefixId != 0 && ImGuiTestEngine_FindByLabelMatchPrefix(ui_ctx, label_task))
+                {
+                    clipper->ForceDisplayRangeByIndices(0, clipper->ItemsCount);
+                    break;
+                }
+    }
+#endif
+
+    for (ImGuiTestFindByLabelTask* label_task : engine->FindByLabelTasks)
+    {
+        // Status flags are not known yet at this point
+        if (label_task->OutItemId != 0 || label_task->InFilterItemStatusFlags != 0)
+            continue;
+        if (!ImGuiTestEngine_FindByLabelMatchSuffix(ui_ctx, label_task, id))
+            continue;
+        if (!ImGuiTestEngine_FindByLabelMatchPrefix(ui_ctx, label_task))
+            continue;
+
+        label_task->OutItemId = id;
+        label_task->OutItemWindow = g.CurrentWindow;
+        label_task->OutItemRect = bb;
+    }
+}
+
 void ImGuiTestEngineHook_ItemAdd(ImGuiContext* ui_ctx, const ImRect& bb, ImGuiID id)
 {
     ImGuiTestEngine* engine = (ImGuiTestEngine*)ui_ctx->TestEngine;
 
     IM_ASSERT(id != 0);
+
+    // Early out for items which no Info/Gather task is interested in.
+    // (hooks are enabled as soon as any task is active, so this is the common path)
+    const bool want_info_task = (engine->InfoTasks.Size > 0) && ImGuiTestEngine_PassInfoTaskFilter(engine, id);
+    if (!want_info_task && engine->GatherTasksCount == 0 && !engine->FindByLabelSearchClipped)
+        return;
+
     ImGuiContext& g = *ui_ctx;
     ImGuiWindow* window = g.CurrentWindow;
     const ImGuiID parent_id = window->IDStack.Size ? window->IDStack.back() : 0;
 
-    // FIXME-OPT: Early out if there are no active Info/Gather tasks.
-
     // Info Tasks
-    if (ImGuiTestInfoTask* task = ImGuiTestEngine_FindInfoTask(engine, id))
+    if (ImGuiTestInfoTask* task = want_info_task ? ImGuiTestEngine_FindInfoTask(engine, id) : NULL)
     {
         ImGuiTestItemInfo* item = &task->Result;
         item->TimestampMain = g.FrameCount;
@@ -1608,98 +2338,72 @@ void ImGuiTestEngineHook_ItemAdd(ImGuiContext* ui_ctx, const ImRect& bb, ImGuiID
         item->StatusFlags = (g.LastItemData.ID == id) ? g.LastItemData.StatusFlags : ImGuiItemStatusFlags_None;
     }
 
-    // Gather Task (only 1 can be active)
-    if (engine->GatherTask.InParentID != 0 && window->DC.NavLayerCurrent == ImGuiNavLayer_Main) // FIXME: Layer filter?
+    // Gather Tasks (multiple can be active, all are matched here)
+    if (engine->GatherTasksCount > 0 && window->DC.NavLayerCurrent == ImGuiNavLayer_Main) // FIXME: Layer filter?
     {
-        const ImGuiID gather_parent_id = engine->GatherTask.InParentID;
-        int depth = -1;
-        if (gather_parent_id == parent_id)
+        for (int task_n = 0; task_n < engine->GatherTasksCount; task_n++)
         {
-            depth = 0;
-        }
-        else
-        {
-            int max_depth = ImMin(window->IDStack.Size, engine->GatherTask.InDepth + ((id == parent_id) ? 1 : 0));
-            for (int n_depth = 1; n_depth < max_depth; n_depth++)
-                if (window->IDStack[window->IDStack.Size - 1 - n_depth] == gather_parent_id)
-                {
-                    depth = n_depth;
-                    break;
-                }
-        }
-        if (depth != -1)
-        {
-            ImGuiTestItemInfo* item = engine->GatherTask.OutList->Pool.GetOrAddByKey(id);
-            item->TimestampMain = engine->FrameCount;
-            item->ID = id;
-            item->ParentID = window->IDStack.back();
-            item->Window = window;
-            item->RectFull = item->RectClipped = bb;
-            item->RectClipped.ClipWithFull(window->ClipRect);      // This two step clipping is important, we want RectClipped to stays within RectFull
-            item->RectClipped.ClipWithFull(item->RectFull);
-            item->NavLayer = window->DC.NavLayerCurrent;
-            item->Depth = depth;
-            engine->GatherTask.LastItemInfo = item;
+            ImGuiTestGatherTask* gather_task = &engine->GatherTasks[task_n];
+            const ImGuiID gather_parent_id = gather_task->InParentID;
+            int depth = -1;
+            if (gather_parent_id == parent_id)
+            {
+                depth = 0;
+            }
+            else
+            {
+                int max_depth = ImMin(window->IDStack.Size, gather_task->InDepth + ((id == parent_id) ? 1 : 0));
+                for (int n_depth = 1; n_depth < max_depth; n_depth++)
+                    if (window->IDStack[window->IDStack.Size - 1 - n_depth] == gather_parent_id)
+                    {
+                        depth = n_depth;
+                        break;
+                    }
+            }
+            if (depth != -1)
+            {
+                ImGuiTestItemInfo* item = gather_task->OutList->Pool.GetOrAddByKey(id);
+                item->TimestampMain = engine->FrameCount;
+                item->ID = id;
+                item->ParentID = window->IDStack.back();
+                item->Window = window;
+                item->RectFull = item->RectClipped = bb;
+                item->RectClipped.ClipWithFull(window->ClipRect);      // This two step clipping is important, we want RectClipped to stays within RectFull
+                item->RectClipped.ClipWithFull(item->RectFull);
+                item->NavLayer = window->DC.NavLayerCurrent;
+                item->Depth = depth;
+                gather_task->LastItemInfo = item;
+            }
         }
     }
+
+    // Find by Label Task (items which are clipped don't report their label in ImGuiTestEngineHook_ItemInfo())
+    if (engine->FindByLabelSearchClipped)
+        ImGuiTestEngineHook_ItemAdd_FindByLabelClipped(ui_ctx, bb, id);
 }
 
 #ifdef IMGUI_HAS_IMSTR
-static void ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ImGuiContext* ui_ctx, ImGuiID id, const ImStrv label, ImGuiItemStatusFlags flags)
+static void ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ImGuiContext* ui_ctx, ImGuiTestFindByLabelTask* label_task, ImGuiID id, const ImStrv label, ImGuiItemStatusFlags flags)
 #else
-static void ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ImGuiContext* ui_ctx, ImGuiID id, const char* label, ImGuiItemStatusFlags flags)
+static void ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ImGuiContext* ui_ctx, ImGuiTestFindByLabelTask* label_task, ImGuiID id, const char* label, ImGuiItemStatusFlags flags)
 #endif
 {
     // At this point "label" is a match for the right-most name in user wildcard (e.g. the "bar" of "**/foo/bar"
-    ImGuiContext& g = *ui_ctx;
-    ImGuiTestEngine* engine = (ImGuiTestEngine*)ui_ctx->TestEngine;
     IM_UNUSED(label); // Match ABI of caller function
 
     // Test for matching status flags
-    ImGuiTestFindByLabelTask* label_task = &engine->FindByLabelTask;
     if (ImGuiItemStatusFlags filter_flags = label_task->InFilterItemStatusFlags)
         if (!(filter_flags & flags))
             return;
 
-    // Test for matching PREFIX (the "window" of "window/**/foo/bar" or the "" of "/**/foo/bar")
-    // FIXME-TESTS: Stack depth limit?
-    // FIXME-TESTS: Recurse back into parent window limit?
-    bool match_prefix = false;
-    if (label_task->InPrefixId == 0)
-    {
-        match_prefix = true;
-    }
-    else
-    {
-        for (ImGuiWindow* window = g.CurrentWindow; window != NULL && !match_prefix; window = window->ParentWindow)
-        {
-            const int id_stack_size = window->IDStack.Size;
-            for (ImGuiID* p_id_stack = window->IDStack.Data + id_stack_size - 1; p_id_stack >= window->IDStack.Data; p_id_stack--)
-                if (*p_id_stack == label_task->InPrefixId)
-                {
-                    match_prefix = true;
-                    break;
-                }
-        }
-    }
-    if (!match_prefix)
+    // Test for matching PREFIX, then for full matching SUFFIX
+    // (because at this point we have only compared the right-most label, e.g. the "bar" of "window/**/foo/bar")
+    if (!ImGuiTestEngine_FindByLabelMatchPrefix(ui_ctx, label_task))
+        return;
+    if (!ImGuiTestEngine_FindByLabelMatchSuffix(ui_ctx, label_task, id))
         return;
 
-    // Test for full matching SUFFIX (the "foo/bar" or "window/**/foo/bar")
-    // Because at this point we have only compared the prefix and the right-most label (the "window" and "bar" or "window/**/foo/bar")
-    // FIXME-TESTS: The entire suffix must be inside the final window.
-    // In theory, someone could craft a suffix that contains sub-window, e.g. "SomeWindow/**/SomeChild_XXXX/SomeItem" and this will fail.
-    {
-        ImGuiWindow* window = g.CurrentWindow;
-        const int id_stack_size = window->IDStack.Size;
-        const int id_stack_pos = id_stack_size - label_task->InSuffixDepth;
-        ImGuiID base_id = id_stack_pos >= 0 ? window->IDStack.Data[id_stack_pos] : 0;   // base_id correspond to the "**"
-        ImGuiID find_id = ImHashDecoratedPath(label_task->InSuffix, NULL, base_id);     // essentially compare the whole "foo/bar" suffix.
-        if (id != find_id)
-            return;
-
-        label_task->OutItemId = id;
-    }
+    label_task->OutItemId = id;
 }
 
 // label is optional
@@ -1726,27 +2430,34 @@ void ImGuiTestEngineHook_ItemInfo(ImGuiContext* ui_ctx, ImGuiID id, const char*
             ImStrncpy(item->DebugLabel, label, IM_ARRAYSIZE(item->DebugLabel));
     }
 
-    // Update Gather Task status flags
-    if (engine->GatherTask.LastItemInfo && engine->GatherTask.LastItemInfo->ID == id)
+    // Update Gather Tasks status flags
+    for (int task_n = 0; task_n < engine->GatherTasksCount; task_n++)
     {
-        ImGuiTestItemInfo* item = engine->GatherTask.LastItemInfo;
-        item->TimestampStatus = g.FrameCount;
-        item->StatusFlags = flags;
-        if (label)
-            ImStrncpy(item->DebugLabel, label, IM_ARRAYSIZE(item->DebugLabel));
+        ImGuiTestGatherTask* gather_task = &engine->GatherTasks[task_n];
+        if (gather_task->LastItemInfo && gather_task->LastItemInfo->ID == id)
+        {
+            ImGuiTestItemInfo* item = gather_task->LastItemInfo;
+            item->TimestampStatus = g.FrameCount;
+            item->StatusFlags = flags;
+            if (label)
+                ImStrncpy(item->DebugLabel, label, IM_ARRAYSIZE(item->DebugLabel));
+        }
     }
 
-    // Update Find by Label Task
-    // FIXME-TESTS FIXME-OPT: Compare by hashes instead of strcmp to support "###" operator.
-    // Perhaps we could use strcmp() if we detect that ### is not used, that would be faster.
-    ImGuiTestFindByLabelTask* label_task = &engine->FindByLabelTask;
-    if (label && label_task->InSuffixLastItem && label_task->OutItemId == 0)
+    // Update Find by Label Tasks
+    // We compare hashes of the last label (which also supports the "###" operator), the filter rejects most labels before scanning pending tasks.
+    if (label && engine->FindByLabelTasks.Size > 0)
+    {
 #ifdef IMGUI_HAS_IMSTR
-        if (label_task->InSuffixLastItemHash == ImHashStr(label))
+        const ImGuiID label_hash = ImHashStr(label);
 #else
-        if (label_task->InSuffixLastItemHash == ImHashStr(label, 0))
+        const ImGuiID label_hash = ImHashStr(label, 0);
 #endif
-            ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ui_ctx, id, label, flags);
+        if (engine->FindByLabelTasksFilter[(label_hash >> 5) & 7] & (1u << (label_hash & 31)))
+            for (ImGuiTestFindByLabelTask* label_task : engine->FindByLabelTasks)
+                if (label_task->OutItemId == 0 && label_task->InSuffixLastItemHash == label_hash)
+                    ImGuiTestEngineHook_ItemInfo_ResolveFindByLabel(ui_ctx, label_task, id, label, flags);
+    }
 }
 
 // Forward core/user-land text to test log
@@ -1762,7 +2473,9 @@ void ImGuiTestEngineHook_Log(ImGuiContext* ui_ctx, const char* fmt, ...)
 
 void ImGuiTestEngine_Assert(const char* expr, const char* file, const char* function, int line)
 {
-    ImGuiTestEngine* engine = GImGuiTestEngine;
+    ImGuiTestEngine* engine = ImGuiTestEngine_GetCurrentEngine();
+    if (engine == NULL)
+        return;
     if (ImGuiTestContext* ctx = engine->TestContext)
     {
         ctx->LogError("Assert: '%s'", expr);
@@ -1789,10 +2502,23 @@ const char* ImGuiTestEngine_FindItemDebugLabel(ImGuiContext* ui_ctx, ImGuiID id)
 // - ImGuiTestEngine_Error()
 //-------------------------------------------------------------------------
 
+// Engine running the test calling the check functions:
+// - Test coroutine (TestFunc): engine owning the coroutine running on this thread, regardless of current dear imgui context.
+// - Main thread (GuiFunc): engine bound to current dear imgui context.
+static ImGuiTestEngine* ImGuiTestEngine_GetCurrentEngine()
+{
+    if (GImGuiTestEngineCurrentThread != NULL)
+        return GImGuiTestEngineCurrentThread;
+    if (ImGuiContext* ui_ctx = ImGui::GetCurrentContext())
+        if (ui_ctx->TestEngine != NULL)
+            return (ImGuiTestEngine*)ui_ctx->TestEngine;
+    return GImGuiTestEngine.load();
+}
+
 // Return true to request a debugger break
 bool ImGuiTestEngine_Check(const char* file, const char* func, int line, ImGuiTestCheckFlags flags, bool result, const char* expr)
 {
-    ImGuiTestEngine* engine = GImGuiTestEngine;
+    ImGuiTestEngine* engine = ImGuiTestEngine_GetCurrentEngine();
     (void)func;
 
     // Removed absolute path from output so we have deterministic output (otherwise __FILE__ gives us machine dending output)
@@ -1896,7 +2622,7 @@ bool ImGuiTestEngine_Error(const char* file, const char* func, int line, ImGuiTe
     bool ret = ImGuiTestEngine_Check(file, func, line, flags, false, buf.c_str());
     va_end(args);
 
-    ImGuiTestEngine* engine = GImGuiTestEngine;
+    ImGuiTestEngine* engine = ImGuiTestEngine_GetCurrentEngine();
     if (engine && engine->Abort)
         return false;
     return ret;
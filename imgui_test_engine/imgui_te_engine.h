@@ -81,7 +81,9 @@ enum ImGuiTestFlags_
     ImGuiTestFlags_None                 = 0,
     ImGuiTestFlags_NoWarmUp             = 1 << 0,   // By default, we run the GUI func twice before starting the test code
     ImGuiTestFlags_NoAutoFinish         = 1 << 1,   // By default, tests with no test func end on Frame 0 (after the warm up). Setting this require test to call ctx->Finish().
-    ImGuiTestFlags_NoRecoverWarnings    = 1 << 2    // Disable state recovery warnings (missing End/Pop calls etc.) for tests which may rely on those.
+    ImGuiTestFlags_NoRecoverWarnings    = 1 << 2,   // Disable state recovery warnings (missing End/Pop calls etc.) for tests which may rely on those.
+    ImGuiTestFlags_RequireRender        = 1 << 3,   // Test relies on ImGui::Render() and the renderer being called every frame (e.g. inspects ImDrawData or draw callbacks). See ImGuiTestEngineIO::IsRequestingRender.
+    ImGuiTestFlags_RequireAppWindows    = 1 << 4    // Test interacts with windows submitted by the application rather than by its GuiFunc (e.g. "Dear ImGui Demo"). Applications running tests in parallel may need to keep those tests together.
     //ImGuiTestFlags_RequireViewports   = 1 << 10
 };
 
@@ -161,6 +163,7 @@ IMGUI_API bool                ImGuiTestEngine_TryAbortEngine(ImGuiTestEngine* en
 IMGUI_API bool                ImGuiTestEngine_IsTestQueueEmpty(ImGuiTestEngine* engine);      // FIXME: Clarify difference between this and io.iSRunningTests
 IMGUI_API void                ImGuiTestEngine_CoroutineStopRequest(ImGuiTestEngine* engine);
 IMGUI_API void                ImGuiTestEngine_GetResult(ImGuiTestEngine* engine, int& count_tested, int& success_count);
+IMGUI_API void                ImGuiTestEngine_GetTestList(ImGuiTestEngine* engine, ImVector<ImGuiTest*>* out_tests);
 IMGUI_API ImGuiPerfTool*      ImGuiTestEngine_GetPerfTool(ImGuiTestEngine* engine);
 IMGUI_API bool                ImGuiTestEngine_UseSimulatedInputs(ImGuiTestEngine* engine);
 
@@ -170,10 +173,15 @@ IMGUI_API void                ImGuiTestEngine_CrashHandler();
 
 // Functions: Internal/Experimental
 IMGUI_API void                ImGuiTestEngine_RebootUiContext(ImGuiTestEngine* engine);
+IMGUI_API void                ImGuiTestEngine_CaptureUiSnapshot(ImGuiTestEngine* engine);           // Capture settings and windows/tables/dock nodes state of the UI context (lighter alternative to ImGuiTestEngine_RebootUiContext())
+IMGUI_API void                ImGuiTestEngine_RestoreUiSnapshot(ImGuiTestEngine* engine);           // Restore state captured by ImGuiTestEngine_CaptureUiSnapshot() (called before each test when IO.ConfigRestoreUiSnapshot is set)
+IMGUI_API void                ImGuiTestEngine_CalcSourceLineEnds(ImGuiTestEngine* engine);          // Calculate ImGuiTest::SourceLineEnd for all registered tests (called by ImGuiTestEngine_Start())
+IMGUI_API void                ImGuiTestEngine_CalcSourceHashes(ImGuiTestEngine* engine);            // Calculate ImGuiTest::SourceHash for all registered tests by reading their source files (called by ImGuiTestEngine_LoadResultCache())
 
 // Function pointers for IO structure
 // (also see imgui_te_coroutine.h for coroutine functions)
 typedef void        (ImGuiTestEngineSrcFileOpenFunc)(const char* filename, int line, void* user_data);
+typedef void        (ImGuiTestEngineAppGuiFunc)(void* user_data);
 
 //-----------------------------------------------------------------------------
 // IO structure to configure the test engine
@@ -191,6 +199,8 @@ struct IMGUI_API ImGuiTestEngineIO
     ImFuncPtr(ImGuiScreenCaptureFunc)           ScreenCaptureFunc = NULL;       // (Optional) To capture graphics output (application _MUST_ call ImGuiTestEngine_PostSwap() function after swapping is framebuffer)
     void*                                       SrcFileOpenUserData = NULL;     // (Optional) User data for SrcFileOpenFunc
     void*                                       ScreenCaptureUserData = NULL;   // (Optional) User data for ScreenCaptureFunc
+    ImFuncPtr(ImGuiTestEngineAppGuiFunc)        TurboAppGuiFunc = NULL;         // (Optional) Submit application windows during turbo frames (see ConfigTurboFrames). Required if tests interact with windows submitted by the application.
+    void*                                       TurboAppGuiUserData = NULL;     // (Optional) User data for TurboAppGuiFunc
 
     // Options: Main
     bool                        ConfigSavedSettings = true;                     // Load/Save settings in main context .ini file.
@@ -206,10 +216,17 @@ struct IMGUI_API ImGuiTestEngineIO
     bool                        ConfigCaptureEnabled = true;        // Master enable flags for capturing and saving captures. Disable to avoid e.g. lengthy saving of large PNG files.
     bool                        ConfigCaptureOnError = false;
     bool                        ConfigNoThrottle = false;           // Disable vsync for performance measurement or fast test running
+    bool                        ConfigInfoTasksFilter = true;       // Reject most items in item hooks with a bloom filter over info task IDs. Disable to measure its benefit (see perf_stress_hook_info_tasks_* tests)
     bool                        ConfigMouseDrawCursor = true;       // Enable drawing of Dear ImGui software mouse cursor when running tests
     float                       ConfigFixedDeltaTime = 0.0f;        // Use fixed delta time instead of calculating it from wall clock
+    int                         ConfigTurboFrames = 0;              // In fast mode, run up to this many extra frames (NewFrame/EndFrame, no rendering) per application frame. Disabled for perf tests and while capturing.
+    bool                        ConfigRestoreUiSnapshot = false;    // Capture a UI context snapshot before running queued tests and restore it before each test, so windows/tables/dock nodes state doesn't leak from one test to another (see ImGuiTestEngine_RestoreUiSnapshot())
+    bool                        ConfigQueueChangedOnly = false;     // ImGuiTestEngine_QueueTests() skips tests which passed in a previous run with same source and build hash (see ImGuiTestEngine_LoadResultCache()). Requires BuildId.
+    int                         ConfigShardIndex = 0;               // Shard queued by ImGuiTestEngine_QueueTests() when ConfigShardCount > 1 (0..ConfigShardCount-1)
+    int                         ConfigShardCount = 1;               // Split tests matched by ImGuiTestEngine_QueueTests() into this many shards of similar expected duration (based on ImGuiTest::StartTime/EndTime)
     int                         PerfStressAmount = 1;               // Integer to scale the amount of items submitted in test
     char                        GitBranchName[64] = "";             // e.g. fill in branch name
+    char                        BuildId[64] = "";                   // Must change whenever code under test changes outside of test sources (which are hashed separately), e.g. hash of library sources or a commit id. Mixed into the build hash of result cache entries. ConfigQueueChangedOnly is ignored without it.
 
     // Options: Speed of user simulation
     float                       MouseSpeed = 600.0f;                // Mouse speed (pixel/second) when not running in fast mode
@@ -242,6 +259,7 @@ struct IMGUI_API ImGuiTestEngineIO
     // State of test engine
     bool                        IsRunningTests = false;
     bool                        IsRequestingMaxAppSpeed = false;    // When running in fast mode: request app to skip vsync or even skip rendering if it wants
+    bool                        IsRequestingRender = true;          // When false, nothing needs this frame's draw data: app may call ImGui::EndFrame() instead of ImGui::Render() and skip rendering (still call ImGuiTestEngine_PostSwap())
     bool                        IsCapturing = false;                // Capture is in progress
 };
 
@@ -287,6 +305,45 @@ struct IMGUI_API ImGuiTestItemList
     const ImGuiTestItemInfo*    operator[] (size_t n)   { return &Pool.Buf[(int)n]; }
 };
 
+//-------------------------------------------------------------------------
+// ImGuiTestFilter
+//-------------------------------------------------------------------------
+
+enum ImGuiTestFilterTermType
+{
+    ImGuiTestFilterTermType_All,        // "all"
+    ImGuiTestFilterTermType_Group,      // "tests", "perfs"
+    ImGuiTestFilterTermType_Substring,  // "foo"
+    ImGuiTestFilterTermType_Prefix,     // "^foo"
+    ImGuiTestFilterTermType_Suffix,     // "foo$"
+    ImGuiTestFilterTermType_Exact,      // "^foo$"
+    ImGuiTestFilterTermType_Glob,       // "foo*bar", "nav_?" (pattern is stored with implicit '*' on sides which are not anchored)
+};
+
+struct ImGuiTestFilterTerm
+{
+    ImGuiTestFilterTermType     Type = ImGuiTestFilterTermType_All;
+    ImGuiTestGroup              Group = ImGuiTestGroup_Unknown; // For ImGuiTestFilterTermType_Group
+    bool                        IsExclude = false;              // '-' prefix
+    int                         PatternOffset = 0;              // Offset of upper-cased, zero-terminated pattern in ImGuiTestFilter::Patterns
+    int                         PatternLen = 0;
+};
+
+// Compiled test filter query (see ImGuiTestFilter::Compile() for syntax)
+// Parse the query once, then match it against any number of tests.
+struct IMGUI_API ImGuiTestFilter
+{
+    ImVector<ImGuiTestFilterTerm>   Terms;
+    ImVector<char>                  Patterns;
+    bool                            IncludeByDefault = false;   // Result when no term is matching (query starts with an exclusion)
+
+    ImGuiTestFilter()                           { }
+    ImGuiTestFilter(const char* filter)         { Compile(filter); }
+    void        Compile(const char* filter);
+    bool        PassFilter(const char* name, ImGuiTestGroup group) const;
+    bool        PassFilter(const ImGuiTest* test) const;
+};
+
 //-------------------------------------------------------------------------
 // ImGuiTestLog
 //-------------------------------------------------------------------------
@@ -345,7 +402,8 @@ struct IMGUI_API ImGuiTest
     bool                            NameOwned = false;              //
     const char*                     SourceFile = NULL;              // __FILE__
     int                             SourceLine = 0;                 // __LINE__
-    int                             SourceLineEnd = 0;              // Calculated by ImGuiTestEngine_StartCalcSourceLineEnds()
+    int                             SourceLineEnd = 0;              // Calculated by ImGuiTestEngine_CalcSourceLineEnds()
+    ImGuiID                         SourceHash = 0;                 // Hash of source lines SourceLine..SourceLineEnd, calculated by ImGuiTestEngine_CalcSourceHashes(). 0 if source file couldn't be read.
     int                             ArgVariant = 0;                 // User parameter. Generally we use it to run variations of a same test by sharing GuiFunc/TestFunc
     ImGuiTestFlags                  Flags = ImGuiTestFlags_None;    // See ImGuiTestFlags_
     ImFuncPtr(ImGuiTestGuiFunc)     GuiFunc = NULL;                 // GUI function (optional if your test are running over an existing GUI application)
@@ -355,8 +413,9 @@ struct IMGUI_API ImGuiTest
     // Test Status
     ImGuiTestStatus                 Status = ImGuiTestStatus_Unknown;
     ImGuiTestLog                    TestLog;
-    ImU64                           StartTime = 0;
-    ImU64                           EndTime = 0;
+    ImU64                           StartTime = 0;                  // Time of last run (in microseconds). StartTime == 0 when restored from a previous run (see ImGuiTestEngine_ImportDurationsFromJUnitXml())
+    ImU64                           EndTime = 0;                    // "
+    int                             FrameCount = 0;                 // Number of frames of last run
     int                             GuiFuncLastFrame = -1;
 
     // User variables (which are instantiated when running the test)
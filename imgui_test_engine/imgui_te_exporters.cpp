@@ -42,6 +42,21 @@ void ImGuiTestEngine_PrintResultSummary(ImGuiTestEngine* engine)
     printf("\nTests Result: %s\n", (count_success == count_tested) ? "OK" : "Errors");
     printf("(%d/%d tests passed)\n", count_success, count_tested);
     ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_White);
+
+    // Frame throughput is mostly useful to compare settings, e.g. coroutine implementations
+    const double duration_secs = (engine->EndTime - engine->StartTime) / 1000000.0;
+    const int frame_count = engine->EndFrameCount - engine->StartFrameCount;
+    if (duration_secs > 0.0 && frame_count > 0)
+    {
+        if (engine->TurboFrameCount > 0)
+            printf("(%d frames in %.2f secs, %.0f frames/sec, %d turbo frames)\n", frame_count, duration_secs, frame_count / duration_secs, engine->TurboFrameCount);
+        else
+            printf("(%d frames in %.2f secs, %.0f frames/sec)\n", frame_count, duration_secs, frame_count / duration_secs);
+    }
+    if (engine->UiSnapshotRestoreCount > 0)
+        printf("(%d UI snapshot restores, %.3f ms avg)\n", engine->UiSnapshotRestoreCount, engine->UiSnapshotRestoreTime / 1000.0 / engine->UiSnapshotRestoreCount);
+    if (engine->ResultCacheSkippedCount > 0)
+        printf("(%d unchanged tests skipped)\n", engine->ResultCacheSkippedCount);
 }
 
 // This is mostly a copy of ImGuiTestEngine_PrintResultSummary with few additions.
@@ -199,7 +214,7 @@ void ImGuiTestEngine_ExportJUnitXml(ImGuiTestEngine* engine, const char* output_
             const char* testcase_name = test->Name;
             const char* testcase_classname = test->Category;
             const char* testcase_status = teststatus_names[test->Status + 1];   // +1 because _Unknown status is -1.
-            float testcase_time = (float)((double)(test->EndTime - test->StartTime) / 1000000.0);
+            float testcase_time = (test->Status != ImGuiTestStatus_Unknown) ? (float)((double)(test->EndTime - test->StartTime) / 1000000.0) : 0.0f;
 
             fprintf(fp, "    <testcase name=\"%s\" assertions=\"0\" classname=\"%s\" status=\"%s\" time=\"%.3f\">\n",
                 testcase_name, testcase_classname, testcase_status, testcase_time);
@@ -293,3 +308,500 @@ void ImGuiTestEngine_ExportJUnitXml(ImGuiTestEngine* engine, const char* output_
     fclose(fp);
     fprintf(stdout, "Saved test results to '%s' successfully.\n", output_file);
 }
+
+//-------------------------------------------------------------------------
+// [SECTION] JUNIT XML IMPORT FUNCTIONS
+//-------------------------------------------------------------------------
+// Only files written by ImGuiTestEngine_ExportJUnitXml() are supported: we rely on each tag being on its own line.
+// - ImGuiTestEngine_ImportDurationsFromJUnitXml()
+// - ImGuiTestEngine_MergeJUnitXml()
+//-------------------------------------------------------------------------
+
+// Return next line and advance 'p'. 'out_tag' points to first non-blank character.
+static bool ImGuiTestEngine_JUnitXmlNextLine(const char** p, const char* buf_end, const char** out_line, const char** out_line_end, const char** out_tag)
+{
+    if (*p >= buf_end)
+        return false;
+    const char* line = *p;
+    const char* line_end = (const char*)memchr(line, '\n', (size_t)(buf_end - line));
+    if (line_end == NULL)
+        line_end = buf_end;
+    const char* tag = line;
+    while (tag < line_end && (*tag == ' ' || *tag == '\t'))
+        tag++;
+    *p = (line_end < buf_end) ? line_end + 1 : buf_end;
+    *out_line = line;
+    *out_line_end = line_end;
+    *out_tag = tag;
+    return true;
+}
+
+static bool ImGuiTestEngine_JUnitXmlIsTag(const char* tag, const char* line_end, const char* tag_prefix)
+{
+    const size_t len = strlen(tag_prefix);
+    return (size_t)(line_end - tag) >= len && memcmp(tag, tag_prefix, len) == 0;
+}
+
+// Read value of attribute 'attr_name' in a line containing a single tag. Return false if attribute is missing.
+static bool ImGuiTestEngine_JUnitXmlGetAttribute(const char* line, const char* line_end, const char* attr_name, Str* out_value)
+{
+    Str64f pattern(" %s=\"", attr_name);
+    const char* value = ImStrstr(line, line_end, pattern.c_str(), NULL);
+    if (value == NULL)
+        return false;
+    value += pattern.length();
+    const char* value_end = (const char*)memchr(value, '\"', (size_t)(line_end - value));
+    if (value_end == NULL)
+        return false;
+    out_value->set(value, value_end);
+    return true;
+}
+
+// Restore ImGuiTest::StartTime/EndTime of tests which haven't run in this session, from durations recorded in a JUnit XML file exported by a previous run.
+// Mostly useful to balance shards (see ImGuiTestEngineIO::ConfigShardCount).
+bool ImGuiTestEngine_ImportDurationsFromJUnitXml(ImGuiTestEngine* engine, const char* filename)
+{
+    IM_ASSERT(engine != NULL);
+    IM_ASSERT(filename != NULL);
+
+    size_t file_size = 0;
+    char* file_data = (char*)ImFileLoadToMemory(filename, "rb", &file_size, 1);
+    if (file_data == NULL)
+        return false;
+
+    Str64 name;
+    Str16 status;
+    Str16 time;
+    const char* p = file_data;
+    const char* line;
+    const char* line_end;
+    const char* tag;
+    while (ImGuiTestEngine_JUnitXmlNextLine(&p, file_data + file_size, &line, &line_end, &tag))
+    {
+        if (!ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "<testcase "))
+            continue;
+        if (!ImGuiTestEngine_JUnitXmlGetAttribute(line, line_end, "name", &name) || !ImGuiTestEngine_JUnitXmlGetAttribute(line, line_end, "status", &status) || !ImGuiTestEngine_JUnitXmlGetAttribute(line, line_end, "time", &time))
+            continue;
+        if (strcmp(status.c_str(), "skipped") == 0)
+            continue;
+        for (ImGuiTest* test : engine->TestsAll)
+            if (test->StartTime == 0 && strcmp(test->Name, name.c_str()) == 0)
+            {
+                test->EndTime = ImMax((ImU64)(atof(time.c_str()) * 1000000.0), (ImU64)1); // Exported with millisecond precision: don't turn fast tests into unknown ones
+                break;
+            }
+    }
+    IM_FREE(file_data);
+    return true;
+}
+
+struct ImGuiTestEngineJUnitXmlRange
+{
+    const char*     Begin = NULL;
+    const char*     End = NULL;
+};
+
+struct ImGuiTestEngineJUnitXmlTestCase
+{
+    ImGuiID         NameId = 0;
+    const char*     Begin = NULL;           // From <testcase> line to </testcase> line, included
+    const char*     End = NULL;
+    bool            Skipped = false;
+    bool            Failed = false;
+};
+
+struct ImGuiTestEngineJUnitXmlTestSuite
+{
+    Str64           Name;
+    Str30           Timestamp;
+    float           Time = 0.0f;
+    ImVector<ImGuiTestEngineJUnitXmlTestCase>   TestCases;
+    ImVector<ImGuiTestEngineJUnitXmlRange>      SystemOut;      // Contents of <system-out> of the suite, for each input file
+    ImVector<ImGuiTestEngineJUnitXmlRange>      SystemErr;
+};
+
+// Merge JUnit XML files exported by the shards of a run (see ImGuiTestEngineIO::ConfigShardCount) into a single file.
+// Each test is taken from the input where it ran (each input lists tests of other shards as skipped). Time is the longest of inputs, as shards run in parallel.
+bool ImGuiTestEngine_MergeJUnitXml(const char* output_file, const char* const* input_files, int input_count)
+{
+    IM_ASSERT(output_file != NULL);
+    IM_ASSERT(input_files != NULL || input_count == 0);
+
+    ImVector<char*> files_data;
+    ImGuiTestEngineJUnitXmlTestSuite testsuites[ImGuiTestGroup_COUNT];
+    float testsuites_time = 0.0f;
+    bool ret = true;
+
+    for (int input_n = 0; input_n < input_count; input_n++)
+    {
+        size_t file_size = 0;
+        char* file_data = (char*)ImFileLoadToMemory(input_files[input_n], "rb", &file_size, 1);
+        if (file_data == NULL)
+        {
+            fprintf(stderr, "Reading '%s' failed.\n", input_files[input_n]);
+            ret = false;
+            continue;
+        }
+        files_data.push_back(file_data);
+
+        ImGuiTestEngineJUnitXmlTestSuite* testsuite = NULL;
+        ImGuiTestEngineJUnitXmlTestCase testcase;
+        ImGuiTestEngineJUnitXmlRange* output_range = NULL;
+        Str64 value;
+        const char* p = file_data;
+        const char* line;
+        const char* line_end;
+        const char* tag;
+        while (ImGuiTestEngine_JUnitXmlNextLine(&p, file_data + file_size, &line, &line_end, &tag))
+        {
+            if (testcase.Begin != NULL)
+            {
+                // Inside <testcase>: copied verbatim
+                if (!ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "</testcase>"))
+                    continue;
+                testcase.End = p;
+                ImGuiTestEngineJUnitXmlTestCase* existing = NULL;
+                for (ImGuiTestEngineJUnitXmlTestCase& other : testsuite->TestCases)
+                    if (other.NameId == testcase.NameId)
+                        existing = &other;
+                if (existing == NULL)
+                    testsuite->TestCases.push_back(testcase);
+                else if (existing->Skipped && !testcase.Skipped)
+                    *existing = testcase;
+                testcase = ImGuiTestEngineJUnitXmlTestCase();
+            }
+            else if (output_range != NULL)
+            {
+                // Inside <system-out>/<system-err> of a suite
+                if (ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "</system-out>") || ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "</system-err>"))
+                {
+                    output_range->End = line;
+                    output_range = NULL;
+                }
+            }
+            else if (ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "<testsuites "))
+            {
+                if (ImGuiTestEngine_JUnitXmlGetAttribute(line, line_end, "time", &value))
+                    testsuites_time = ImMax(testsuites_time, (float)atof(value.c_str()));
+            }
+            else if (ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "<testsuite "))
+            {
+                testsuite = NULL;
+                if (!ImGuiTestEngine_JUnitXmlGetAttribute(line, line_end, "id", &value))
+                    continue;
+                const int testsuite_id = atoi(value.c_str());
+                if (testsuite_id < 0 || testsuite_id >= ImGuiTestGroup_COUNT)
+                    continue;
+                testsuite = &testsuites[testsuite_id];
+                if (testsuite->Name.empty())
+                {
+                    ImGuiTestEngine_JUnitXmlGetAttribute(line, line_end, "name", &testsuite->Name);
+                    ImGuiTestEngine_JUnitXmlGetAttribute(line, line_end, "timestamp", &testsuite->Timestamp);
+                }
+                if (ImGuiTestEngine_JUnitXmlGetAttribute(line, line_end, "time", &value))
+                    testsuite->Time = ImMax(testsuite->Time, (float)atof(value.c_str()));
+            }
+            else if (testsuite == NULL)
+            {
+                continue;
+            }
+            else if (ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "<testcase "))
+            {
+                if (!ImGuiTestEngine_JUnitXmlGetAttribute(line, line_end, "name", &value))
+                    continue;
+                testcase.NameId = ImHashStr(value.c_str());
+                testcase.Begin = line;
+                if (ImGuiTestEngine_JUnitXmlGetAttribute(line, line_end, "status", &value))
+                {
+                    testcase.Skipped = (strcmp(value.c_str(), "skipped") == 0);
+                    testcase.Failed = (strcmp(value.c_str(), "error") == 0);
+                }
+            }
+            else if (ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "<system-out>") || ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "<system-err>"))
+            {
+                const bool is_system_out = ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "<system-out>");
+                ImVector<ImGuiTestEngineJUnitXmlRange>& ranges = is_system_out ? testsuite->SystemOut : testsuite->SystemErr;
+                ranges.push_back(ImGuiTestEngineJUnitXmlRange());
+                output_range = &ranges.back();
+                output_range->Begin = p;
+            }
+            else if (ImGuiTestEngine_JUnitXmlIsTag(tag, line_end, "</testsuite>"))
+            {
+                testsuite = NULL;
+            }
+        }
+    }
+
+    FILE* fp = ret ? fopen(output_file, "w+b") : NULL;
+    if (fp == NULL)
+    {
+        if (ret)
+            fprintf(stderr, "Writing '%s' failed.\n", output_file);
+        for (char* file_data : files_data)
+            IM_FREE(file_data);
+        return false;
+    }
+
+    int testsuites_tests = 0;
+    int testsuites_failures = 0;
+    int testsuites_disabled = 0;
+    for (ImGuiTestEngineJUnitXmlTestSuite& testsuite : testsuites)
+        for (ImGuiTestEngineJUnitXmlTestCase& testcase : testsuite.TestCases)
+        {
+            testsuites_tests++;
+            testsuites_failures += testcase.Failed ? 1 : 0;
+            testsuites_disabled += testcase.Skipped ? 1 : 0;
+        }
+
+    fprintf(fp, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        "<testsuites disabled=\"%d\" errors=\"0\" failures=\"%d\" name=\"%s\" tests=\"%d\" time=\"%.3f\">\n",
+        testsuites_disabled, testsuites_failures, "Dear ImGui", testsuites_tests, testsuites_time);
+    for (int testsuite_id = ImGuiTestGroup_Tests; testsuite_id < ImGuiTestGroup_COUNT; testsuite_id++)
+    {
+        ImGuiTestEngineJUnitXmlTestSuite& testsuite = testsuites[testsuite_id];
+        if (testsuite.Name.empty())
+            continue;
+        int failures = 0;
+        int disabled = 0;
+        for (ImGuiTestEngineJUnitXmlTestCase& testcase : testsuite.TestCases)
+        {
+            failures += testcase.Failed ? 1 : 0;
+            disabled += testcase.Skipped ? 1 : 0;
+        }
+        fprintf(fp, "  <testsuite name=\"%s\" tests=\"%d\" disabled=\"%d\" errors=\"0\" failures=\"%d\" hostname=\"\" id=\"%d\" package=\"\" skipped=\"0\" time=\"%.3f\" timestamp=\"%s\">\n",
+            testsuite.Name.c_str(), testsuite.TestCases.Size, disabled, failures, testsuite_id, testsuite.Time, testsuite.Timestamp.c_str());
+        for (ImGuiTestEngineJUnitXmlTestCase& testcase : testsuite.TestCases)
+            fwrite(testcase.Begin, 1, (size_t)(testcase.End - testcase.Begin), fp);
+        for (int output_n = 0; output_n < 2; output_n++)
+        {
+            ImVector<ImGuiTestEngineJUnitXmlRange>& ranges = (output_n == 0) ? testsuite.SystemOut : testsuite.SystemErr;
+            if (ranges.empty())
+                continue;
+            fprintf(fp, (output_n == 0) ? "    <system-out>\n" : "    <system-err>\n");
+            for (ImGuiTestEngineJUnitXmlRange& range : ranges)
+                if (range.End != NULL)
+                    fwrite(range.Begin, 1, (size_t)(range.End - range.Begin), fp);
+            fprintf(fp, (output_n == 0) ? "    </system-out>\n" : "    </system-err>\n");
+        }
+        fprintf(fp, "  </testsuite>\n");
+    }
+    fprintf(fp, "</testsuites>\n");
+    fclose(fp);
+
+    for (char* file_data : files_data)
+        IM_FREE(file_data);
+    fprintf(stdout, "Merged %d test results into '%s' successfully.\n", input_count, output_file);
+    return true;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] TEST RESULT RECORDS
+//-------------------------------------------------------------------------
+// Text records used to send results of a test ran by another engine/process, e.g. by worker processes of imgui_tests.
+// - ImGuiTestEngine_WriteTestResult()
+// - ImGuiTestEngine_ReadTestResult()
+//-------------------------------------------------------------------------
+// Format (one record per test, log lines never contain '\n'):
+//   test <status> <start_time> <end_time> <frame_count> <name>
+//   log <verbose_level> <text>
+//   end
+//-------------------------------------------------------------------------
+
+void ImGuiTestEngine_WriteTestResult(ImGuiTest* test, ImGuiTextBuffer* out_buf)
+{
+    IM_ASSERT(test->Status != ImGuiTestStatus_Queued && test->Status != ImGuiTestStatus_Running);
+    out_buf->appendf("test %d %llu %llu %d %s\n", test->Status, test->StartTime, test->EndTime, test->FrameCount, test->Name);
+    for (ImGuiTestLogLineInfo& line_info : test->TestLog.LineInfo)
+    {
+        const char* line_start = test->TestLog.Buffer.c_str() + line_info.LineOffset;
+        const char* line_end = strchr(line_start, '\n');
+        out_buf->appendf("log %d ", line_info.Level);
+        out_buf->append(line_start, line_end ? line_end + 1 : NULL);
+        if (line_end == NULL)
+            out_buf->append("\n");
+    }
+    out_buf->append("end\n");
+}
+
+// Apply record to registered test of same name, and extend engine's StartTime/EndTime so summary and exporters report the whole run.
+// Return NULL if record is malformed or test is not registered.
+ImGuiTest* ImGuiTestEngine_ReadTestResult(ImGuiTestEngine* engine, const char* record, const char* record_end)
+{
+    const char* line = NULL;
+    const char* line_end = NULL;
+    const char* tag = NULL;
+    const char* p = record;
+    if (!ImGuiTestEngine_JUnitXmlNextLine(&p, record_end, &line, &line_end, &tag))
+        return NULL;
+
+    int status = 0;
+    ImU64 start_time = 0;
+    ImU64 end_time = 0;
+    int frame_count = 0;
+    int name_offset = 0;
+    if (sscanf(line, "test %d %llu %llu %d %n", &status, &start_time, &end_time, &frame_count, &name_offset) != 4 || name_offset == 0 || line + name_offset > line_end)
+        return NULL;
+    if (status != ImGuiTestStatus_Unknown && status != ImGuiTestStatus_Success && status != ImGuiTestStatus_Error)
+        return NULL;
+
+    Str128 name;
+    name.set(line + name_offset, line_end);
+    ImGuiTest* test = NULL;
+    for (ImGuiTest* registered_test : engine->TestsAll)
+        if (strcmp(registered_test->Name, name.c_str()) == 0)
+        {
+            test = registered_test;
+            break;
+        }
+    if (test == NULL)
+        return NULL;
+
+    test->Status = (ImGuiTestStatus)status;
+    test->StartTime = start_time;
+    test->EndTime = end_time;
+    test->FrameCount = frame_count;
+    test->TestLog.Clear();
+    while (ImGuiTestEngine_JUnitXmlNextLine(&p, record_end, &line, &line_end, &tag))
+    {
+        int level = 0;
+        int text_offset = 0;
+        if (sscanf(line, "log %d %n", &level, &text_offset) != 1 || text_offset == 0 || level <= ImGuiTestVerboseLevel_Silent || level >= ImGuiTestVerboseLevel_COUNT)
+            continue;
+        const char* text = ImMin(line + text_offset, line_end);  // ' %n' skips '\n' of an empty line
+        const int prev_size = test->TestLog.Buffer.size();
+        test->TestLog.Buffer.append(text, line_end);
+        test->TestLog.Buffer.append("\n");
+        test->TestLog.UpdateLineOffsets(&engine->IO, (ImGuiTestVerboseLevel)level, test->TestLog.Buffer.begin() + prev_size);
+    }
+
+    if (start_time != 0 && (engine->StartTime == 0 || start_time < engine->StartTime))
+        engine->StartTime = start_time;
+    if (end_time > engine->EndTime)
+        engine->EndTime = end_time;
+    return test;
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] RESULT CACHE
+//-------------------------------------------------------------------------
+// Results of previous runs, to only run tests whose inputs changed since they last passed (see ImGuiTestEngineIO::ConfigQueueChangedOnly).
+// - ImGuiTestEngine_CalcBuildHash()
+// - ImGuiTestEngine_FindResultCacheEntry()
+// - ImGuiTestEngine_LoadResultCache()
+// - ImGuiTestEngine_SaveResultCache()
+//-------------------------------------------------------------------------
+// Format (one line per test, lines starting with ';' are ignored):
+//   <source_hash> <build_hash> <status> <duration_us> <frame_count> <name>
+//-------------------------------------------------------------------------
+
+// Hash of dear imgui version and data layout, along with IO.BuildId provided by application.
+// Only IO.BuildId can reflect code changes, which is why IO.ConfigQueueChangedOnly requires it.
+ImGuiID ImGuiTestEngine_CalcBuildHash(ImGuiTestEngine* engine)
+{
+    const size_t layout[] = { IMGUI_VERSION_NUM, sizeof(ImGuiIO), sizeof(ImGuiStyle), sizeof(ImGuiContext), sizeof(ImGuiWindow), sizeof(ImGuiTable), sizeof(ImDrawVert), sizeof(ImDrawIdx), sizeof(ImWchar) };
+    ImGuiID hash = ImHashStr(IMGUI_VERSION);
+    hash = ImHashStr(ImGui::GetVersion(), 0, hash);
+    hash = ImHashData(layout, sizeof(layout), hash);
+    hash = ImHashStr(engine->IO.BuildId, 0, hash);
+    return hash;
+}
+
+const ImGuiTestResultCacheEntry* ImGuiTestEngine_FindResultCacheEntry(ImGuiTestEngine* engine, const ImGuiTest* test)
+{
+    const int index = engine->ResultCacheIndex.GetInt(ImHashData(test->Name, strlen(test->Name)), -1);
+    return (index != -1) ? &engine->ResultCache[index] : NULL;
+}
+
+static bool ImGuiTestEngine_ReadResultCacheFile(const char* filename, ImVector<ImGuiTestResultCacheEntry>* out_entries, ImGuiStorage* out_index)
+{
+    size_t file_size = 0;
+    char* file_data = (char*)ImFileLoadToMemory(filename, "rb", &file_size, 1);
+    if (file_data == NULL)
+        return false;
+
+    const char* p = file_data;
+    const char* line;
+    const char* line_end;
+    const char* tag;
+    while (ImGuiTestEngine_JUnitXmlNextLine(&p, file_data + file_size, &line, &line_end, &tag))
+    {
+        ImGuiTestResultCacheEntry entry;
+        int status = 0;
+        int name_offset = 0;
+        if (line[0] == ';' || sscanf(line, "%X %X %d %llu %d %n", &entry.SourceHash, &entry.BuildHash, &status, &entry.Duration, &entry.FrameCount, &name_offset) != 5 || name_offset == 0 || line + name_offset >= line_end)
+            continue;
+        const char* name_end = (line_end[-1] == '\r') ? line_end - 1 : line_end;
+        entry.NameHash = ImHashData(line + name_offset, (size_t)(name_end - (line + name_offset)));
+        entry.Status = (ImGuiTestStatus)status;
+        out_index->Data.push_back(ImGuiStorage::ImGuiStoragePair(entry.NameHash, out_entries->Size));
+        out_entries->push_back(entry);
+    }
+    out_index->BuildSortByKey();
+    IM_FREE(file_data);
+    return true;
+}
+
+// Load results recorded by ImGuiTestEngine_SaveResultCache(), and calculate source hashes of registered tests to compare with them.
+// Also restore ImGuiTest::StartTime/EndTime of tests which haven't run in this session, like ImGuiTestEngine_ImportDurationsFromJUnitXml().
+bool ImGuiTestEngine_LoadResultCache(ImGuiTestEngine* engine, const char* filename)
+{
+    IM_ASSERT(engine != NULL);
+    IM_ASSERT(filename != NULL);
+
+    engine->ResultCache.clear();
+    engine->ResultCacheIndex.Clear();
+    engine->ResultCacheSkippedCount = 0;
+    ImGuiTestEngine_CalcSourceHashes(engine);
+    if (!ImGuiTestEngine_ReadResultCacheFile(filename, &engine->ResultCache, &engine->ResultCacheIndex))
+        return false;
+
+    for (ImGuiTest* test : engine->TestsAll)
+        if (test->StartTime == 0)
+            if (const ImGuiTestResultCacheEntry* entry = ImGuiTestEngine_FindResultCacheEntry(engine, test))
+                if (entry->Duration > 0)
+                {
+                    test->EndTime = entry->Duration;
+                    test->FrameCount = entry->FrameCount;
+                }
+    return true;
+}
+
+// Write results of tests which ran (successfully or not) in this session, and keep existing entries of other registered tests.
+// Entries of tests which are not registered anymore are dropped.
+bool ImGuiTestEngine_SaveResultCache(ImGuiTestEngine* engine, const char* filename)
+{
+    IM_ASSERT(engine != NULL);
+    IM_ASSERT(filename != NULL);
+
+    if (!engine->SourceHashesValid)
+        ImGuiTestEngine_CalcSourceHashes(engine);
+    ImVector<ImGuiTestResultCacheEntry> prev_entries;
+    ImGuiStorage prev_index;
+    ImGuiTestEngine_ReadResultCacheFile(filename, &prev_entries, &prev_index);
+
+    FILE* fp = fopen(filename, "w+b");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Writing '%s' failed.\n", filename);
+        return false;
+    }
+    const ImGuiID build_hash = ImGuiTestEngine_CalcBuildHash(engine);
+    fprintf(fp, "; Dear ImGui Test Engine result cache\n");
+    fprintf(fp, "; <source_hash> <build_hash> <status> <duration_us> <frame_count> <name>\n");
+    for (ImGuiTest* test : engine->TestsAll)
+    {
+        if (test->StartTime != 0 && (test->Status == ImGuiTestStatus_Success || test->Status == ImGuiTestStatus_Error))
+        {
+            fprintf(fp, "%08X %08X %d %llu %d %s\n", test->SourceHash, build_hash, test->Status, test->EndTime - test->StartTime, test->FrameCount, test->Name);
+            continue;
+        }
+        const int prev_index_n = prev_index.GetInt(ImHashData(test->Name, strlen(test->Name)), -1);
+        if (prev_index_n != -1)
+        {
+            const ImGuiTestResultCacheEntry& entry = prev_entries[prev_index_n];
+            fprintf(fp, "%08X %08X %d %llu %d %s\n", entry.SourceHash, entry.BuildHash, entry.Status, entry.Duration, entry.FrameCount, test->Name);
+        }
+    }
+    fclose(fp);
+    return true;
+}
@@ -31,12 +31,20 @@
 //          node_modules/xunit-viewer/bin/xunit-viewer -r junit.xml -o junit.html
 //    - Open junit.html
 //
+// Sharded runs (see ImGuiTestEngineIO::ConfigShardCount) export one file per shard, which may be merged afterwards:
+//          imgui_tests -nopause -nogui -shard 1/2 -shard-durations junit.xml -export-file junit.shard1.xml tests
+//          imgui_tests -nopause -nogui -shard 2/2 -shard-durations junit.xml -export-file junit.shard2.xml tests
+//          imgui_tests -merge-junit junit.xml junit.shard1.xml junit.shard2.xml
+// Using results of a previous run with -shard-durations (see ImGuiTestEngine_ImportDurationsFromJUnitXml()) makes shards finish at about the same time.
+//
 
 //-------------------------------------------------------------------------
 // Forward Declarations
 //-------------------------------------------------------------------------
 
+struct ImGuiTest;
 struct ImGuiTestEngine;
+struct ImGuiTextBuffer;
 
 //-------------------------------------------------------------------------
 // Types
@@ -56,3 +64,12 @@ void ImGuiTestEngine_PrintResultSummary(ImGuiTestEngine* engine);
 
 void ImGuiTestEngine_Export(ImGuiTestEngine* engine);
 void ImGuiTestEngine_ExportEx(ImGuiTestEngine* engine, ImGuiTestEngineExportFormat format, const char* filename);
+
+bool ImGuiTestEngine_ImportDurationsFromJUnitXml(ImGuiTestEngine* engine, const char* filename);                // Restore durations of tests from a previous run, to balance shards (see ImGuiTestEngineIO::ConfigShardCount)
+bool ImGuiTestEngine_MergeJUnitXml(const char* output_file, const char* const* input_files, int input_count);  // Merge results exported by each shard of a run
+
+bool ImGuiTestEngine_LoadResultCache(ImGuiTestEngine* engine, const char* filename);                     // Load results of previous runs, used by ImGuiTestEngineIO::ConfigQueueChangedOnly (also restores durations, see ImGuiTestEngineIO::ConfigShardCount)
+bool ImGuiTestEngine_SaveResultCache(ImGuiTestEngine* engine, const char* filename);                     // Update file with results of tests which ran, along with hashes of their source and of the build
+
+void       ImGuiTestEngine_WriteTestResult(ImGuiTest* test, ImGuiTextBuffer* out_buf);                         // Append a text record with status, times and log of a test which ran
+ImGuiTest* ImGuiTestEngine_ReadTestResult(ImGuiTestEngine* engine, const char* record, const char* record_end);  // Apply a record to the registered test of same name (e.g. in another process), return NULL on failure
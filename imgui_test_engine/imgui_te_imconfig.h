@@ -26,6 +26,22 @@
 #define IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL 0
 #endif
 
+// [Optional, default 1000] Number of iterations the std::thread futex-based implementation spins before parking a thread (see Coroutine_ImplStdThreadFutex_GetInterface())
+#ifndef IMGUI_TEST_ENGINE_COROUTINE_FUTEX_SPIN_COUNT
+#define IMGUI_TEST_ENGINE_COROUTINE_FUTEX_SPIN_COUNT 1000
+#endif
+
+// [Optional, default 0] Enable coroutine implementation using ucontext (POSIX only), switching stacks on the calling thread instead of handing off to another thread.
+// Used to automatically fill ImGuiTestEngineIO::CoroutineFuncs only when the std::thread implementation is disabled.
+#ifndef IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+#define IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL 0
+#endif
+
+// [Optional, default 8 MB] Stack size of coroutines created by the ucontext implementation (memory is only committed when used)
+#ifndef IMGUI_TEST_ENGINE_COROUTINE_UCONTEXT_STACK_SIZE
+#define IMGUI_TEST_ENGINE_COROUTINE_UCONTEXT_STACK_SIZE (8 * 1024 * 1024)
+#endif
+
 // Define our own IM_DEBUG_BREAK macros.
 // This allows us to define a macro below that will let us break directly in the right call-stack (instead of a function)
 // (this is a copy of the one in imgui_internal.h. if the one in imgui_internal.h were to be defined at the top of imgui.h we could use that one)
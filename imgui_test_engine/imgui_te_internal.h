@@ -9,6 +9,7 @@
 //-------------------------------------------------------------------------
 
 struct ImGuiPerfTool;
+struct ImPlotContext;
 
 //-------------------------------------------------------------------------
 // DATA STRUCTURES
@@ -26,6 +27,24 @@ struct ImGuiTestInfoTask
     ImGuiTestItemInfo       Result;
 };
 
+// Slab allocator for info tasks.
+// Tasks are carved out of fixed-size blocks which are never moved nor released until Clear(), so a task pointer
+// (and the ImGuiTestItemInfo* handed out to tests) stays valid for the whole lifetime of the task.
+// Freed tasks are recycled through a free-list: once warmed up, creating/collecting tasks doesn't touch the heap.
+struct ImGuiTestInfoTaskPool
+{
+    enum { BlockSize = 64 };
+    ImVector<ImGuiTestInfoTask*>    Blocks;                     // Each block holds BlockSize tasks
+    ImVector<ImGuiTestInfoTask*>    FreeList;                   // Available tasks (capacity is reserved ahead so pushing never allocates)
+    int                             AliveCount = 0;             // Number of tasks currently allocated
+    int                             HeapAllocCount = 0;         // Total number of heap allocations made by the pool (for monitoring)
+
+    ~ImGuiTestInfoTaskPool()        { Clear(); }
+    ImGuiTestInfoTask*              Alloc();
+    void                            Free(ImGuiTestInfoTask* task);
+    void                            Clear();
+};
+
 // Gather item list in given parent ID.
 struct ImGuiTestGatherTask
 {
@@ -36,6 +55,7 @@ struct ImGuiTestGatherTask
     // Output/Temp
     ImGuiTestItemList*      OutList = NULL;
     ImGuiTestItemInfo*      LastItemInfo = NULL;
+    int                     OutListStartSize = 0;   // Size of OutList when the task was started (for logging)
 };
 
 // Find item ID given a label and a parent id
@@ -52,6 +72,8 @@ struct ImGuiTestFindByLabelTask
 
     // Output
     ImGuiID                 OutItemId = 0;                  // Result item ID
+    ImGuiWindow*            OutItemWindow = NULL;           // Result item window, only set when matched as a clipped item
+    ImRect                  OutItemRect;                    // Result item rectangle, only set when matched as a clipped item
 };
 
 // Processed by test queue
@@ -107,32 +129,71 @@ struct ImGuiTestInputs
     float                       HostEscDownDuration = -1.0f;    // Maintain our own DownDuration for host/backend ESC key so we can abort.
 };
 
+// Result of last run of a test, as persisted by ImGuiTestEngine_SaveResultCache()
+struct ImGuiTestResultCacheEntry
+{
+    ImGuiID                     NameHash = 0;
+    ImGuiID                     SourceHash = 0;                 // ImGuiTest::SourceHash at the time of the run
+    ImGuiID                     BuildHash = 0;                  // ImGuiTestEngine_CalcBuildHash() at the time of the run
+    ImGuiTestStatus             Status = ImGuiTestStatus_Unknown;
+    ImU64                       Duration = 0;                   // In microseconds
+    int                         FrameCount = 0;
+};
+
 // [Internal] Test Engine Context
 struct ImGuiTestEngine
 {
     ImGuiTestEngineIO           IO;
     ImGuiContext*               UiContextTarget = NULL;         // imgui context for testing
     ImGuiContext*               UiContextActive = NULL;         // imgui context for testing == UiContextTarget or NULL
+    ImPlotContext*              PlotContext = NULL;             // implot context current when starting, bound by the test coroutine (if IMGUI_TEST_ENGINE_ENABLE_IMPLOT)
 
     bool                        Started = false;
     ImU64                       StartTime = 0;
     ImU64                       EndTime = 0;
+    int                         StartFrameCount = 0;            // FrameCount when the last batch of tests started (StartTime)
+    int                         EndFrameCount = 0;              // FrameCount when the last batch of tests ended (EndTime)
     int                         FrameCount = 0;
     float                       OverrideDeltaTime = -1.0f;      // Inject custom delta time into imgui context to simulate clock passing faster than wall clock time.
+    float                       ExtraTime = 0.0f;               // Virtual clock: time accumulated by ImGuiTestEngine_AddExtraTime(), injected as the whole delta time of next frame (takes priority over OverrideDeltaTime)
     ImVector<ImGuiTest*>        TestsAll;
     ImVector<ImGuiTestRunTask>  TestsQueue;
     ImGuiTestContext*           TestContext = NULL;
-    ImVector<ImGuiTestInfoTask*>InfoTasks;
-    ImGuiTestGatherTask         GatherTask;
-    ImGuiTestFindByLabelTask    FindByLabelTask;
+    ImVector<ImGuiTestInfoTask*>InfoTasks;                      // Active info tasks (unordered, GC does swap-removes)
+    ImGuiTestInfoTaskPool       InfoTasksPool;                  // Storage for InfoTasks[]
+    ImVector<ImGuiTestInfoTask*>InfoTasksIndex;                 // Open-addressing hash index of InfoTasks[] keyed by ID (linear probing, power-of-two size, NULL = empty slot)
+    ImU32                       InfoTasksFilter[128] = {};      // Bloom filter (4096 bits, 2 probes) over InfoTasks[] IDs, allows hooks to reject most items without touching the index
+    ImGuiTestGatherTask         GatherTasks[8];                 // Active gather tasks are GatherTasks[0..GatherTasksCount-1], all matched in the same pass
+    int                         GatherTasksCount = 0;
+    ImVector<ImGuiTestFindByLabelTask*> FindByLabelTasks;       // Pending wildcard queries (owned by caller, see ImGuiTestEngine_AddFindByLabelTask())
+    ImU32                       FindByLabelTasksFilter[8] = {}; // Set of InSuffixLastItemHash values of FindByLabelTasks[] (256 bits, direct-mapped), checked before scanning the tasks
+    ImGuiItemStatusFlags        FindByLabelFilterItemStatusFlags = 0; // Status flags required for wildcard matches (set by ItemAction() to resolve ambiguities)
+    bool                        FindByLabelSearchClipped = false;     // Also match items which don't report their label because they are clipped (see ImGuiTestEngineHook_ItemAdd())
     void*                       UserDataBuffer = NULL;
     size_t                      UserDataBufferSize = 0;
     ImGuiTestCoroutineHandle    TestQueueCoroutine = NULL;      // Coroutine to run the test queue
     bool                        TestQueueCoroutineShouldExit = false; // Flag to indicate that we are shutting down and the test queue coroutine should stop
+    bool                        TurboFramesRunning = false;     // Running extra frames from ImGuiTestEngine_PostNewFrame() (see IO.ConfigTurboFrames)
+    int                         TurboFrameCount = 0;            // Number of extra frames run in the last batch of tests
+    float                       TurboFramesDeltaTime = 0.0f;    // Delta time provided by the application for its current frame, before any override (reused by extra frames)
+    bool                        SourceHashesValid = false;      // Set by ImGuiTestEngine_CalcSourceHashes()
+    ImVector<ImGuiTestResultCacheEntry> ResultCache;            // Loaded by ImGuiTestEngine_LoadResultCache()
+    ImGuiStorage                ResultCacheIndex;               // NameHash -> index in ResultCache[]
+    int                         ResultCacheSkippedCount = 0;    // Number of tests skipped by ImGuiTestEngine_QueueTests() because of IO.ConfigQueueChangedOnly
 
     // Inputs
     ImGuiTestInputs             Inputs;
 
+    // UI context snapshot (see ImGuiTestEngine_CaptureUiSnapshot(), IO.ConfigRestoreUiSnapshot)
+    bool                        UiSnapshotValid = false;
+    ImGuiTextBuffer             UiSnapshotSettings;             // Output of "Window", "Table" and "Docking" .ini handlers at the time of capture
+    ImVector<char>              UiSnapshotSettingsParseBuf;     // Copy of UiSnapshotSettings, modified in place when parsing
+    ImGuiStorage                UiSnapshotWindows;              // IDs of windows existing at the time of capture
+    ImGuiStorage                UiSnapshotTables;               // IDs of tables existing at the time of capture
+    int                         UiSnapshotRestoreCount = 0;     // Number of ImGuiTestEngine_RestoreUiSnapshot() calls in the last batch of tests
+    ImU64                       UiSnapshotRestoreTime = 0;      // Total duration of those calls (in microseconds)
+    ImU64                       UiContextRebootTime = 0;        // Duration of the last ImGuiTestEngine_RebootUiContext() call (in microseconds), for comparison
+
     // UI support
     bool                        Abort = false;
     bool                        UiFocus = false;
@@ -166,6 +227,7 @@ struct ImGuiTestEngine
     int                         ToolSlowDownMs = 100;
     ImGuiTestRunSpeed           BackupConfigRunSpeed = ImGuiTestRunSpeed_Fast;
     bool                        BackupConfigNoThrottle = false;
+    float                       BackupConfigFixedDeltaTime = 0.0f;
 
     // Functions
     ImGuiTestEngine();
@@ -177,12 +239,19 @@ struct ImGuiTestEngine
 //-------------------------------------------------------------------------
 
 ImGuiTestItemInfo*  ImGuiTestEngine_FindItemInfo(ImGuiTestEngine* engine, ImGuiID id, const char* debug_id);
+void                ImGuiTestEngine_AddFindByLabelTask(ImGuiTestEngine* engine, ImGuiTestFindByLabelTask* task);
+void                ImGuiTestEngine_RemoveFindByLabelTask(ImGuiTestEngine* engine, ImGuiTestFindByLabelTask* task);
 void                ImGuiTestEngine_Yield(ImGuiTestEngine* engine);
 void                ImGuiTestEngine_SetDeltaTime(ImGuiTestEngine* engine, float delta_time);
+void                ImGuiTestEngine_AddExtraTime(ImGuiTestEngine* engine, float extra_time);
 int                 ImGuiTestEngine_GetFrameCount(ImGuiTestEngine* engine);
 double              ImGuiTestEngine_GetPerfDeltaTime500Average(ImGuiTestEngine* engine);
 bool                ImGuiTestEngine_PassFilter(ImGuiTest* test, const char* filter);
 
+// Result cache
+ImGuiID             ImGuiTestEngine_CalcBuildHash(ImGuiTestEngine* engine);
+const ImGuiTestResultCacheEntry* ImGuiTestEngine_FindResultCacheEntry(ImGuiTestEngine* engine, const ImGuiTest* test);
+
 // Screen/Video Capturing
 bool                ImGuiTestEngine_CaptureScreenshot(ImGuiTestEngine* engine, ImGuiCaptureArgs* args);
 bool                ImGuiTestEngine_CaptureBeginVideo(ImGuiTestEngine* engine, ImGuiCaptureArgs* args);
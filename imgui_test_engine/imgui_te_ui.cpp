@@ -193,11 +193,11 @@ static void HelpTooltip(const char* desc)
         ImGui::SetTooltip("%s", desc);
 }
 
-static bool ShowTestGroupFilterTest(ImGuiTestEngine* e, ImGuiTestGroup group, const char* filter, ImGuiTest* test)
+static bool ShowTestGroupFilterTest(ImGuiTestEngine* e, ImGuiTestGroup group, const ImGuiTestFilter& filter, ImGuiTest* test)
 {
     if (test->Group != group)
         return false;
-    if (!ImGuiTestEngine_PassFilter(test, *filter ? filter : "all"))
+    if (!filter.PassFilter(test))
         return false;
     if ((e->UiFilterByStatusMask & (1 << test->Status)) == 0)
         return false;
@@ -208,15 +208,16 @@ static void GetFailingTestsAsString(ImGuiTestEngine* e, ImGuiTestGroup group, ch
 {
     IM_ASSERT(out_string != NULL);
     bool first = true;
+    const char* filter_str = group == ImGuiTestGroup_Tests ? e->UiFilterTests : e->UiFilterPerfs;
+    ImGuiTestFilter filter(*filter_str ? filter_str : "all");
     for (int i = 0; i < e->TestsAll.Size; i++)
     {
         ImGuiTest* failing_test = e->TestsAll[i];
-        const char* filter = group == ImGuiTestGroup_Tests ? e->UiFilterTests : e->UiFilterPerfs;
         if (failing_test->Group != group)
             continue;
         if (failing_test->Status != ImGuiTestStatus_Error)
             continue;
-        if (!ImGuiTestEngine_PassFilter(failing_test, *filter ? filter : "all"))
+        if (!filter.PassFilter(failing_test))
             continue;
         if (!first)
             out_string->append(separator);
@@ -247,6 +248,9 @@ static void ShowTestGroup(ImGuiTestEngine* e, ImGuiTestGroup group, char* filter
     ImGuiIO& io = ImGui::GetIO();
     const float dpi_scale = GetDpiScale();
 
+    // Compile filter once for all tests (recompiled below if edited)
+    ImGuiTestFilter test_filter(*filter ? filter : "all");
+
     // Save position of test run status button and make space for it.
     const ImVec2 status_button_pos = ImGui::GetCursorPos();
     ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImGui::GetFrameHeight() + style.ItemInnerSpacing.x);
@@ -257,7 +261,7 @@ static void ShowTestGroup(ImGuiTestEngine* e, ImGuiTestGroup group, char* filter
         for (int n = 0; n < e->TestsAll.Size; n++)
         {
             ImGuiTest* test = e->TestsAll[n];
-            if (!ShowTestGroupFilterTest(e, group, filter, test))
+            if (!ShowTestGroupFilterTest(e, group, test_filter, test))
                 continue;
             ImGuiTestEngine_QueueTest(e, test, ImGuiTestRunFlags_None);
         }
@@ -296,14 +300,16 @@ static void ShowTestGroup(ImGuiTestEngine* e, ImGuiTestGroup group, char* filter
     }
     filter_width -= ImGui::CalcTextSize("?").x + style.ItemSpacing.x;
     ImGui::SetNextItemWidth(ImMax(20.0f, filter_width));
-    ImGui::InputText("##filter", filter, filter_size);
+    if (ImGui::InputText("##filter", filter, filter_size))
+        test_filter.Compile(*filter ? filter : "all");
     ImGui::SameLine();
     ImGui::TextDisabled("?");
     HelpTooltip("Query is composed of one or more comma-separated filter terms with optional modifiers.\n"
         "Available modifiers:\n"
         "- '-' prefix excludes tests matched by the term.\n"
         "- '^' prefix anchors term matching to the start of the string.\n"
-        "- '$' suffix anchors term matching to the end of the string.");
+        "- '$' suffix anchors term matching to the end of the string.\n"
+        "- '*' matches any characters, '?' matches any single character.");
     if (group == ImGuiTestGroup_Perfs)
     {
         ImGui::SameLine();
@@ -334,7 +340,7 @@ static void ShowTestGroup(ImGuiTestEngine* e, ImGuiTestGroup group, char* filter
         for (int test_n = 0; test_n < e->TestsAll.Size; test_n++)
         {
             ImGuiTest* test = e->TestsAll[test_n];
-            if (!ShowTestGroupFilterTest(e, group, filter, test))
+            if (!ShowTestGroupFilterTest(e, group, test_filter, test))
                 continue;
 
             ImGuiTestContext* test_context = (e->TestContext && e->TestContext->Test == test) ? e->TestContext : NULL;
@@ -594,10 +600,22 @@ static void ImGuiTestEngine_ShowLogAndTools(ImGuiTestEngine* engine)
         ImGuiIO& io = ImGui::GetIO();
         ImGui::Text("%.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
         ImGui::Text("TestEngine: HookItems: %d, HookPushId: %d, InfoTasks: %d", g.TestEngineHookItems, g.DebugHookIdInfo != 0, engine->InfoTasks.Size);
+        ImGui::Text("TestEngine: InfoTasksPool: %d blocks, %d free, %d heap allocs", engine->InfoTasksPool.Blocks.Size, engine->InfoTasksPool.FreeList.Size, engine->InfoTasksPool.HeapAllocCount);
         ImGui::Separator();
 
         if (ImGui::Button("Reboot UI context"))
             engine->ToolDebugRebootUiContext = true;
+        if (engine->UiContextRebootTime > 0)
+        {
+            ImGui::SameLine();
+            ImGui::Text("Last reboot: %.3f ms", engine->UiContextRebootTime / 1000.0);
+        }
+        ImGui::Checkbox("Restore UI snapshot before each test", &engine->IO.ConfigRestoreUiSnapshot); HelpTooltip("Capture settings and windows/tables/dock nodes state before running queued tests, and restore them before each test.\nMuch cheaper than rebooting the UI context.");
+        if (engine->UiSnapshotRestoreCount > 0)
+        {
+            ImGui::SameLine();
+            ImGui::Text("Last batch: %d restores, %.3f ms avg", engine->UiSnapshotRestoreCount, engine->UiSnapshotRestoreTime / 1000.0 / engine->UiSnapshotRestoreCount);
+        }
 
         const ImGuiInputTextCallback filter_callback = [](ImGuiInputTextCallbackData* data) { return (data->EventChar == ',' || data->EventChar == ';') ? 1 : 0; };
         ImGui::InputText("Branch/Annotation", engine->IO.GitBranchName, IM_ARRAYSIZE(engine->IO.GitBranchName), ImGuiInputTextFlags_CallbackCharFilter, filter_callback, NULL);
@@ -635,6 +653,7 @@ static void ImGuiTestEngine_ShowLogAndTools(ImGuiTestEngine* engine)
             ImGui::SameLine();
             if (ImGui::Button("Pick ref dt"))
                 engine->PerfRefDeltaTime = dt_1000;
+            ImGui::Checkbox("Info tasks filter", &engine->IO.ConfigInfoTasksFilter); HelpTooltip("Reject most items in item hooks with a bloom filter over info task IDs.\nDisable to measure its benefit.");
 
             double dt_ref = engine->PerfRefDeltaTime;
             ImGui::Text("[ref dt]    %6.3f ms", engine->PerfRefDeltaTime * 1000);
@@ -10,6 +10,7 @@
 #include "imgui_test_engine/imgui_te_engine.h"      // IM_REGISTER_TEST()
 #include "imgui_test_engine/imgui_te_context.h"
 #include "imgui_test_engine/imgui_te_utils.h"       // ImHashDecoratedPath()
+#include "imgui_test_engine/imgui_te_exporters.h"   // ImGuiTestEngine_MergeJUnitXml()
 #include "imgui_test_engine/imgui_capture_tool.h"
 #include "imgui_test_engine/thirdparty/Str/Str.h"
 #if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
@@ -334,6 +335,7 @@ void RegisterTests_Window(ImGuiTestEngine* e)
 
     // ## Test popup focus and right-click to close popups up to a given level
     t = IM_REGISTER_TEST(e, "window", "window_popup_focus");
+    t->Flags |= ImGuiTestFlags_RequireAppWindows;
     t->TestFunc = [](ImGuiTestContext* ctx)
     {
         ImGuiContext& g = *ctx->UiContext;
@@ -912,6 +914,7 @@ void RegisterTests_Window(ImGuiTestEngine* e)
 #if IMGUI_VERSION_NUM >= 18727
     // ## Test menuset separation.
     t = IM_REGISTER_TEST(e, "window", "window_popup_menusets");
+    t->Flags |= ImGuiTestFlags_RequireAppWindows;
     t->TestFunc = [](ImGuiTestContext* ctx)
     {
         ImGuiContext& g = *ctx->UiContext;
@@ -2546,6 +2549,7 @@ void RegisterTests_DrawList(ImGuiTestEngine* e)
 
     // ## Test AddCallback()
     t = IM_REGISTER_TEST(e, "drawlist", "drawlist_callbacks");
+    t->Flags |= ImGuiTestFlags_RequireRender; // Callbacks are called by renderer
     t->GuiFunc = [](ImGuiTestContext* ctx)
     {
         ImGui::SetNextWindowScroll(ImVec2(0.0f, 0.0f));
@@ -3280,6 +3284,45 @@ void RegisterTests_Inputs(ImGuiTestEngine* e)
 // Tests: Misc
 //-------------------------------------------------------------------------
 
+// Run all tests registered in 'engine' on a throwaway dear imgui context sharing our font atlas.
+// Useful to test engine behaviors (e.g. failing tests) without affecting the engine running us.
+static void RunTestsOnNestedEngine(ImGuiTestContext* ctx, ImGuiTestEngine* engine, int max_frames = 500)
+{
+    ImGuiContext* backup_ui_ctx = ImGui::GetCurrentContext();
+    ImFontAtlas* atlas = ctx->UiContext->IO.Fonts;
+    const bool backup_atlas_locked = atlas->Locked;
+    ImGuiContext* ui_ctx = ImGui::CreateContext(atlas);
+    ImGui::SetCurrentContext(ui_ctx);
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1280.0f, 720.0f);
+
+    ImGuiTestEngineIO& engine_io = ImGuiTestEngine_GetIO(engine);
+    engine_io.ConfigSavedSettings = false;
+    engine_io.ConfigRunSpeed = ImGuiTestRunSpeed_Fast;
+    engine_io.CoroutineFuncs = ctx->EngineIO->CoroutineFuncs;
+    ImGuiTestEngine_Start(engine, ui_ctx);
+
+    ImVector<ImGuiTest*> tests;
+    ImGuiTestEngine_GetTestList(engine, &tests);
+    for (ImGuiTest* test : tests)
+        ImGuiTestEngine_QueueTest(engine, test);
+    for (int frame_n = 0; frame_n < max_frames && !ImGuiTestEngine_IsTestQueueEmpty(engine); frame_n++)
+    {
+        io.DeltaTime = 1.0f / 60.0f;
+        ImGui::NewFrame();
+        if (engine_io.IsRequestingRender)
+            ImGui::Render();
+        else
+            ImGui::EndFrame();
+    }
+
+    ImGuiTestEngine_Stop(engine);
+    ImGui::DestroyContext(ui_ctx);
+    ImGui::SetCurrentContext(backup_ui_ctx);
+    atlas->Locked = backup_atlas_locked;
+}
+
 void RegisterTests_Misc(ImGuiTestEngine* e)
 {
     ImGuiTest* t = NULL;
@@ -3447,6 +3490,188 @@ void RegisterTests_Misc(ImGuiTestEngine* e)
         ctx->ItemClick("**/Hello###Test3");
     };
 
+    // ## Test ItemInfoBatch() resolving multiple items in the same frames
+    t = IM_REGISTER_TEST(e, "misc", "misc_ref_batch");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        for (int n = 0; n < 50; n++)
+        {
+            ImGui::PushID(Str30f("%d", n).c_str()); // String IDs so they can be referred to as "%d/Button"
+            ImGui::Button("Button");
+            ImGui::PopID();
+        }
+        ImGui::BeginChild("Child", ImVec2(100, 100));
+        ImGui::Button("Button In Child");
+        ImGui::EndChild();
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ctx->SetRef("Test Window");
+
+        Str30 paths[50];
+        ImGuiTestRef refs[52];
+        ImGuiTestItemInfo* items[52];
+        for (int n = 0; n < 50; n++)
+        {
+            paths[n].setf("%d/Button", n);
+            refs[n] = paths[n].c_str();
+        }
+        refs[50] = "**/Button In Child";
+        refs[51] = "Not A Button";
+
+        const int frame_count = ctx->FrameCount;
+        int found_count = ctx->ItemInfoBatch(refs, 50, items);
+        IM_CHECK_EQ(found_count, 50);
+        IM_CHECK_LE(ctx->FrameCount - frame_count, 2);
+        for (int n = 0; n < 50; n++)
+        {
+            IM_CHECK(items[n] != NULL);
+            IM_CHECK_EQ(items[n]->ID, ctx->GetID(refs[n]));
+        }
+
+        // Wildcard and missing items
+        found_count = ctx->ItemInfoBatch(refs, 52, items, ImGuiTestOpFlags_NoError);
+        IM_CHECK_EQ(found_count, 51);
+        IM_CHECK(items[50] != NULL && items[50]->Window != NULL && (items[50]->Window->Flags & ImGuiWindowFlags_ChildWindow));
+        IM_CHECK(items[51] == NULL);
+    };
+
+    // ## Test resolving multiple wildcard references simultaneously
+    t = IM_REGISTER_TEST(e, "misc", "misc_ref_batch_wildcard");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        for (int n = 0; n < 20; n++)
+        {
+            ImGui::PushID(n);
+            ImGui::BeginChild("Child", ImVec2(100, 30));
+            ImGui::Text("Child %d", n);
+            ImGui::PushID("Group");
+            ImGui::Button(Str30f("Button %d", n).c_str());
+            ImGui::PopID();
+            ImGui::EndChild();
+            ImGui::PopID();
+        }
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ctx->SetRef("Test Window");
+
+        Str30 paths[20];
+        ImGuiTestRef refs[20];
+        ImGuiTestItemInfo* items[20];
+        for (int n = 0; n < 20; n++)
+        {
+            paths[n].setf("**/Group/Button %d", n);
+            refs[n] = paths[n].c_str();
+        }
+
+        // All queries are matched in the same frames
+        const int frame_count = ctx->FrameCount;
+        int found_count = ctx->ItemInfoBatch(refs, 20, items);
+        IM_CHECK_EQ(found_count, 20);
+        IM_CHECK_LE(ctx->FrameCount - frame_count, 4);
+        for (int n = 0; n < 20; n++)
+        {
+            IM_CHECK(items[n] != NULL);
+            IM_CHECK(items[n]->Window != NULL && (items[n]->Window->Flags & ImGuiWindowFlags_ChildWindow));
+            IM_CHECK_STR_EQ(items[n]->DebugLabel, Str30f("Button %d", n).c_str());
+        }
+    };
+
+    // ## Test caching of resolved wildcard references
+    t = IM_REGISTER_TEST(e, "misc", "misc_ref_cache");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiTestGenericVars& vars = ctx->GenericVars;
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::Button("Button");
+        ImGui::BeginChild(vars.Bool1 ? "Child B" : "Child A", ImVec2(100, 50));
+        if (ImGui::Button("Button In Child"))
+            vars.Count++;
+        ImGui::EndChild();
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiTestGenericVars& vars = ctx->GenericVars;
+        ctx->SetRef("Test Window");
+        IM_CHECK_EQ(ctx->RefCache.Size, 0);
+
+        // Plain paths are not cached
+        const ImGuiID button_id = ctx->GetID("Button");
+        for (int n = 0; n < 10; n++)
+            IM_CHECK_EQ(ctx->GetID("Button"), button_id);
+        ctx->ItemClick("Button");
+        IM_CHECK_EQ(ctx->RefCache.Size, 0);
+        IM_CHECK_EQ(ctx->RefCacheHits + ctx->RefCacheMisses, 0);
+
+        // Wildcard paths: only first query needs matching
+        ctx->ItemClick("**/Button In Child");
+        const int misses = ctx->RefCacheMisses;
+        const int frame_count = ctx->FrameCount;
+        ImGuiTestItemInfo* item = ctx->ItemInfo("**/Button In Child");
+        IM_CHECK(item != NULL);
+        IM_CHECK_EQ(ctx->RefCacheMisses, misses);
+        IM_CHECK_LE(ctx->FrameCount - frame_count, 1);
+        for (int n = 0; n < 4; n++)
+            ctx->ItemClick("**/Button In Child");
+        IM_CHECK_EQ(vars.Count, 5);
+
+        // Stale result is resolved again, reusing the same entry
+        const ImGuiID child_a_button_id = item->ID;
+        const int cache_paths_size = ctx->RefCachePaths.size();
+        vars.Bool1 = true;
+        ctx->Yield();
+        item = ctx->ItemInfo("**/Button In Child");
+        IM_CHECK(item != NULL && item->ID != child_a_button_id);
+        IM_CHECK_EQ(ctx->RefCache.Size, 1);
+        IM_CHECK_EQ(ctx->RefCachePaths.size(), cache_paths_size);
+        ctx->ItemClick("**/Button In Child");
+        IM_CHECK_EQ(vars.Count, 6);
+
+        // Changing reference clears the cache
+        ctx->SetRef(ImGuiTestRef());
+        ctx->SetRef("Test Window");
+        IM_CHECK_EQ(ctx->RefCache.Size, 0);
+    };
+
+    // ## Test running multiple GatherItems() queries simultaneously
+    t = IM_REGISTER_TEST(e, "misc", "misc_ref_gather_multiple");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        for (int group_n = 0; group_n < 3; group_n++)
+        {
+            ImGui::PushID(Str30f("%d", group_n).c_str()); // String IDs so they can be referred to as "%d/%d/Button"
+            for (int n = 0; n < 5 + group_n; n++)
+            {
+                ImGui::PushID(Str30f("%d", n).c_str());
+                ImGui::Button("Button");
+                ImGui::PopID();
+            }
+            ImGui::PopID();
+        }
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ctx->SetRef("Test Window");
+        ImGuiTestItemList items[3];
+        ctx->GatherItemsBegin(&items[0], "0");
+        ctx->GatherItemsBegin(&items[1], "1");
+        ctx->GatherItemsBegin(&items[2], "2");
+        ctx->GatherItemsEnd();
+        for (int group_n = 0; group_n < 3; group_n++)
+        {
+            IM_CHECK_EQ(items[group_n].GetSize(), 5 + group_n);
+            IM_CHECK(items[group_n].GetByID(ctx->GetID(Str30f("%d/0/Button", group_n).c_str())) != NULL);
+        }
+    };
+
     // ## Test hash functions and ##/### operators
     t = IM_REGISTER_TEST(e, "misc", "misc_hash_001");
     t->TestFunc = [](ImGuiTestContext* ctx)
@@ -4328,6 +4553,306 @@ void RegisterTests_Misc(ImGuiTestEngine* e)
         IM_CHECK(filter.PassFilter("cartender") == false);
     };
 
+    // ## Test ImGuiTestFilter (test engine queries)
+    t = IM_REGISTER_TEST(e, "misc", "misc_test_engine_filter");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiTestFilter filter;
+        filter.Compile("");
+        IM_CHECK(filter.PassFilter("nav_basic", ImGuiTestGroup_Tests) == false);
+
+        filter.Compile("all");
+        IM_CHECK(filter.PassFilter("nav_basic", ImGuiTestGroup_Tests) == true);
+        IM_CHECK(filter.PassFilter("perf_misc", ImGuiTestGroup_Perfs) == true);
+
+        filter.Compile("tests,-scroll,-^nav_");
+        IM_CHECK(filter.PassFilter("widgets_button", ImGuiTestGroup_Tests) == true);
+        IM_CHECK(filter.PassFilter("widgets_button", ImGuiTestGroup_Perfs) == false);
+        IM_CHECK(filter.PassFilter("window_scroll_basic", ImGuiTestGroup_Tests) == false);
+        IM_CHECK(filter.PassFilter("nav_basic", ImGuiTestGroup_Tests) == false);
+        IM_CHECK(filter.PassFilter("table_nav_basic", ImGuiTestGroup_Tests) == true);
+
+        filter.Compile("-Button");
+        IM_CHECK(filter.PassFilter("widgets_button", ImGuiTestGroup_Tests) == false);
+        IM_CHECK(filter.PassFilter("widgets_checkbox", ImGuiTestGroup_Perfs) == true);
+
+        filter.Compile("_basic$,^NAV_");
+        IM_CHECK(filter.PassFilter("window_basic", ImGuiTestGroup_Tests) == true);
+        IM_CHECK(filter.PassFilter("window_basic_2", ImGuiTestGroup_Tests) == false);
+        IM_CHECK(filter.PassFilter("nav_scroll", ImGuiTestGroup_Tests) == true);
+
+        filter.Compile("^nav_basic$");
+        IM_CHECK(filter.PassFilter("nav_basic", ImGuiTestGroup_Tests) == true);
+        IM_CHECK(filter.PassFilter("nav_basic_2", ImGuiTestGroup_Tests) == false);
+
+        // Globs
+        filter.Compile("^nav_*_scroll$");
+        IM_CHECK(filter.PassFilter("nav_page_scroll", ImGuiTestGroup_Tests) == true);
+        IM_CHECK(filter.PassFilter("nav__scroll", ImGuiTestGroup_Tests) == true);
+        IM_CHECK(filter.PassFilter("nav_page_scroll_2", ImGuiTestGroup_Tests) == false);
+        IM_CHECK(filter.PassFilter("table_nav_page_scroll", ImGuiTestGroup_Tests) == false);
+
+        filter.Compile("table*resize,-table_?_resize");
+        IM_CHECK(filter.PassFilter("table_column_resize", ImGuiTestGroup_Tests) == true);
+        IM_CHECK(filter.PassFilter("misc_table_sizing_resize_2", ImGuiTestGroup_Tests) == true);
+        IM_CHECK(filter.PassFilter("table_a_resize", ImGuiTestGroup_Tests) == false);
+        IM_CHECK(filter.PassFilter("table_column", ImGuiTestGroup_Tests) == false);
+    };
+
+    // ## Test ImGuiTestEngine_CalcSourceLineEnds()
+    t = IM_REGISTER_TEST(e, "misc", "misc_test_engine_source_line_ends");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+        ImGuiTestEngine_GetIO(engine).ConfigSavedSettings = false;
+        ImGuiTest* a1 = ImGuiTestEngine_RegisterTest(engine, "misc", "a1", "a.cpp", 10);
+        ImGuiTest* b2 = ImGuiTestEngine_RegisterTest(engine, "misc", "b2", "b.cpp", 50);
+        ImGuiTest* a3 = ImGuiTestEngine_RegisterTest(engine, "misc", "a3", "a.cpp", 30);
+        ImGuiTest* a2 = ImGuiTestEngine_RegisterTest(engine, "misc", "a2", "a.cpp", 20);
+        ImGuiTest* a2b = ImGuiTestEngine_RegisterTest(engine, "misc", "a2b", "a.cpp", 20);
+        ImGuiTest* b1 = ImGuiTestEngine_RegisterTest(engine, "misc", "b1", "b.cpp", 5);
+        ImGuiTestEngine_CalcSourceLineEnds(engine);
+        IM_CHECK_EQ(a1->SourceLineEnd, 20);
+        IM_CHECK_EQ(a2->SourceLineEnd, 30);
+        IM_CHECK_EQ(a2b->SourceLineEnd, 30);
+        IM_CHECK_EQ(a3->SourceLineEnd, 30);
+        IM_CHECK_EQ(b1->SourceLineEnd, 50);
+        IM_CHECK_EQ(b2->SourceLineEnd, 50);
+        ImGuiTestEngine_DestroyContext(engine);
+    };
+
+    // ## Test Sleep() advancing the virtual clock in fast mode
+    t = IM_REGISTER_TEST(e, "misc", "misc_test_engine_sleep_virtual_clock");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiTestGenericVars& vars = ctx->GenericVars;
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::Button("Hold");
+        if (ImGui::IsItemActive() && ImGui::GetIO().MouseDownDuration[0] >= 1.0f)
+            vars.Bool1 = true;
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiTestGenericVars& vars = ctx->GenericVars;
+        if (ctx->EngineIO->ConfigRunSpeed != ImGuiTestRunSpeed_Fast)
+            return;
+
+        const double start_time = ctx->UiContext->Time;
+        const int start_frame = ctx->FrameCount;
+        ctx->Sleep(5.0f);
+        IM_CHECK_GE(ctx->UiContext->Time - start_time, 5.0);
+        IM_CHECK_LE(ctx->FrameCount - start_frame, 2);
+
+        ctx->SetRef("Test Window");
+        ctx->ItemHold("Hold", 1.0f);
+        IM_CHECK(vars.Bool1);
+    };
+
+    // ## Test running extra frames without rendering (ImGuiTestEngineIO::ConfigTurboFrames)
+    t = IM_REGISTER_TEST(e, "misc", "misc_test_engine_turbo_frames");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiTestGenericVars& vars = ctx->GenericVars;
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        if (ImGui::Button("Button"))
+            vars.Count++;
+        ImGui::End();
+        if (ctx->UiContext->FrameCountRendered != ctx->UiContext->FrameCount - 1)
+            vars.Int1++; // Previous frame was not rendered
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiTestGenericVars& vars = ctx->GenericVars;
+        const int backup_turbo_frames = ctx->EngineIO->ConfigTurboFrames;
+        ctx->EngineIO->ConfigTurboFrames = 3;
+        ctx->Yield(10);
+        vars.Int1 = 0;
+        ctx->SetRef("Test Window");
+        ctx->ItemClick("Button");
+        ctx->Yield(10);
+        ctx->EngineIO->ConfigTurboFrames = backup_turbo_frames;
+
+        IM_CHECK_EQ(vars.Count, 1);
+        bool expect_turbo_frames = (ctx->EngineIO->ConfigRunSpeed == ImGuiTestRunSpeed_Fast);
+#ifdef IMGUI_HAS_VIEWPORT
+        if (ctx->UiContext->IO.ConfigFlags & ImGuiConfigFlags_ViewportsEnable)
+            expect_turbo_frames = false;
+#endif
+        if (expect_turbo_frames)
+            IM_CHECK_GT(vars.Int1, 0);
+    };
+
+    // ## Test ImGuiTestEngineIO::IsRequestingRender letting the application skip ImGui::Render()
+    t = IM_REGISTER_TEST(e, "misc", "misc_test_engine_request_render");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        auto gui_func = [](ImGuiTestContext* ctx)
+        {
+            ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+            if (ImGui::Button("Button"))
+                ctx->GenericVars.Count++;
+            ImGui::End();
+        };
+
+        ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+        ImGuiTest* test_no_render = ImGuiTestEngine_RegisterTest(engine, "misc", "no_render");
+        test_no_render->GuiFunc = gui_func;
+        test_no_render->TestFunc = [](ImGuiTestContext* ctx)
+        {
+            ctx->Yield();
+            IM_CHECK(ctx->EngineIO->IsRequestingRender == false);
+            const int frame_count_rendered = ctx->UiContext->FrameCountRendered;
+            ctx->SetRef("Test Window");
+            ctx->ItemClick("Button");
+            IM_CHECK_EQ(ctx->GenericVars.Count, 1);
+            IM_CHECK_EQ(ctx->UiContext->FrameCountRendered, frame_count_rendered);
+        };
+        ImGuiTest* test_render = ImGuiTestEngine_RegisterTest(engine, "misc", "render");
+        test_render->Flags |= ImGuiTestFlags_RequireRender;
+        test_render->GuiFunc = gui_func;
+        test_render->TestFunc = [](ImGuiTestContext* ctx)
+        {
+            ctx->Yield(2);
+            IM_CHECK(ctx->EngineIO->IsRequestingRender == true);
+            IM_CHECK_EQ(ctx->UiContext->FrameCountRendered, ctx->UiContext->FrameCount - 1);
+        };
+        RunTestsOnNestedEngine(ctx, engine);
+
+        const ImGuiTestStatus status_no_render = test_no_render->Status;
+        const ImGuiTestStatus status_render = test_render->Status;
+        ImGuiTestEngine_DestroyContext(engine);
+        IM_CHECK(status_no_render == ImGuiTestStatus_Success);
+        IM_CHECK(status_render == ImGuiTestStatus_Success);
+    };
+
+    // ## Test ImGuiTestEngineIO::ConfigShardCount splitting queued tests into shards of similar expected duration
+    t = IM_REGISTER_TEST(e, "misc", "misc_test_engine_shards");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        const char* test_names[] = { "t0", "t1", "t2", "t3", "t4", "t5", "t6", "t7", "t8", "t9" };
+        const int test_durations_ms[] = { 10, 90, 5, 40, 70, 20, 50, 5, 30, 10 };
+        const int shard_count = 3;
+        int test_shard_hits[IM_ARRAYSIZE(test_names)] = {};
+        int shard_durations_ms[shard_count] = {};
+        for (int shard_n = 0; shard_n < shard_count; shard_n++)
+        {
+            // Queued tests can't be queued again: select each shard on a fresh engine, as each process of a sharded run does.
+            ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+            ImGuiTestEngineIO& engine_io = ImGuiTestEngine_GetIO(engine);
+            engine_io.ConfigSavedSettings = false;
+            engine_io.ConfigShardCount = shard_count;
+            engine_io.ConfigShardIndex = shard_n;
+            ImGuiTest* tests[IM_ARRAYSIZE(test_names)];
+            for (int test_n = 0; test_n < IM_ARRAYSIZE(test_names); test_n++)
+            {
+                tests[test_n] = ImGuiTestEngine_RegisterTest(engine, "misc", test_names[test_n]);
+                tests[test_n]->EndTime = (ImU64)test_durations_ms[test_n] * 1000; // As restored by ImGuiTestEngine_ImportDurationsFromJUnitXml()
+            }
+            ImGuiTestEngine_QueueTests(engine, ImGuiTestGroup_Tests, "all");
+            for (int test_n = 0; test_n < IM_ARRAYSIZE(test_names); test_n++)
+                if (tests[test_n]->Status == ImGuiTestStatus_Queued)
+                {
+                    test_shard_hits[test_n]++;
+                    shard_durations_ms[shard_n] += test_durations_ms[test_n];
+                }
+            ImGuiTestEngine_DestroyContext(engine);
+        }
+
+        // Shards are disjoint and cover all tests
+        for (int test_n = 0; test_n < IM_ARRAYSIZE(test_names); test_n++)
+            IM_CHECK_EQ(test_shard_hits[test_n], 1);
+
+        // Longest tests first to the least loaded shard: here totals end up within the shortest test of each other (110 ms each)
+        int min_duration_ms = INT_MAX, max_duration_ms = 0;
+        for (int shard_n = 0; shard_n < shard_count; shard_n++)
+        {
+            min_duration_ms = ImMin(min_duration_ms, shard_durations_ms[shard_n]);
+            max_duration_ms = ImMax(max_duration_ms, shard_durations_ms[shard_n]);
+        }
+        IM_CHECK_LE(max_duration_ms - min_duration_ms, 5);
+    };
+
+    // ## Test ImGuiTestEngine_MergeJUnitXml() merging results exported by each shard
+    t = IM_REGISTER_TEST(e, "misc", "misc_test_engine_merge_junit");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        // Each shard exports all tests, tests of other shards being reported as skipped
+        const char* input_files[] = { "output/misc_merge_junit_shard1.xml", "output/misc_merge_junit_shard2.xml" };
+        const char* output_file = "output/misc_merge_junit.xml";
+        const ImGuiTestStatus shard_statuses[2][3] =
+        {
+            { ImGuiTestStatus_Success, ImGuiTestStatus_Unknown, ImGuiTestStatus_Error },
+            { ImGuiTestStatus_Unknown, ImGuiTestStatus_Success, ImGuiTestStatus_Unknown },
+        };
+        ImFileCreateDirectoryChain("output");
+        for (int shard_n = 0; shard_n < 2; shard_n++)
+        {
+            ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+            ImGuiTestEngine_GetIO(engine).ConfigSavedSettings = false;
+            ImGuiTestEngine_RegisterTest(engine, "misc", "merge_a")->Status = shard_statuses[shard_n][0];
+            ImGuiTestEngine_RegisterTest(engine, "misc", "merge_b")->Status = shard_statuses[shard_n][1];
+            ImGuiTestEngine_RegisterTest(engine, "misc", "merge_c")->Status = shard_statuses[shard_n][2];
+            ImGuiTestEngine_ExportEx(engine, ImGuiTestEngineExportFormat_JUnitXml, input_files[shard_n]);
+            ImGuiTestEngine_DestroyContext(engine);
+        }
+        const bool merged = ImGuiTestEngine_MergeJUnitXml(output_file, input_files, IM_ARRAYSIZE(input_files));
+        char* merged_data = merged ? (char*)ImFileLoadToMemory(output_file, "rb", NULL, 1) : NULL;
+        Str256 merged_text(merged_data ? merged_data : "");
+        IM_FREE(merged_data);
+        for (const char* input_file : input_files)
+            ImFileDelete(input_file);
+        ImFileDelete(output_file);
+
+        IM_CHECK(merged);
+        IM_CHECK(strstr(merged_text.c_str(), "<testsuites disabled=\"0\" errors=\"0\" failures=\"1\" name=\"Dear ImGui\" tests=\"3\"") != NULL);
+        IM_CHECK(strstr(merged_text.c_str(), "<testcase name=\"merge_a\" assertions=\"0\" classname=\"misc\" status=\"success\"") != NULL);
+        IM_CHECK(strstr(merged_text.c_str(), "<testcase name=\"merge_b\" assertions=\"0\" classname=\"misc\" status=\"success\"") != NULL);
+        IM_CHECK(strstr(merged_text.c_str(), "<testcase name=\"merge_c\" assertions=\"0\" classname=\"misc\" status=\"error\"") != NULL);
+        IM_CHECK(strstr(merged_text.c_str(), "status=\"skipped\"") == NULL);
+    };
+
+    // ## Test recovering from a test failing between GatherItemsBegin() and GatherItemsEnd()
+    t = IM_REGISTER_TEST(e, "misc", "misc_test_engine_gather_early_exit");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        auto gui_func = [](ImGuiTestContext* ctx)
+        {
+            ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+            ImGui::Button("A");
+            ImGui::Button("B");
+            ImGui::End();
+        };
+
+        ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+        ImGuiTest* test_fail = ImGuiTestEngine_RegisterTest(engine, "misc", "gather_fail");
+        test_fail->GuiFunc = gui_func;
+        test_fail->TestFunc = [](ImGuiTestContext* ctx)
+        {
+            ImGuiTestItemList items; // Freed on early exit, engine must not write into it anymore
+            ctx->GatherItemsBegin(&items, "Test Window");
+            ctx->Yield();
+            IM_CHECK(false);
+            ctx->GatherItemsEnd();
+        };
+        ImGuiTest* test_next = ImGuiTestEngine_RegisterTest(engine, "misc", "gather_next");
+        test_next->GuiFunc = gui_func;
+        test_next->TestFunc = [](ImGuiTestContext* ctx)
+        {
+            ImGuiTestItemList items;
+            ctx->GatherItems(&items, "Test Window");
+            IM_CHECK(items.GetByID(ctx->GetID("Test Window/A")) != NULL);
+            IM_CHECK(items.GetByID(ctx->GetID("Test Window/B")) != NULL);
+        };
+        RunTestsOnNestedEngine(ctx, engine);
+
+        const ImGuiTestStatus status_fail = test_fail->Status;
+        const ImGuiTestStatus status_next = test_next->Status;
+        ImGuiTestEngine_DestroyContext(engine);
+        IM_CHECK(status_fail == ImGuiTestStatus_Error);
+        IM_CHECK(status_next == ImGuiTestStatus_Success);
+    };
+
     // ## Visual ImBezierClosestPoint test.
     t = IM_REGISTER_TEST(e, "misc", "misc_bezier_closest_point");
     t->GuiFunc = [](ImGuiTestContext* ctx)
@@ -462,6 +462,7 @@ void RegisterTests_Docking(ImGuiTestEngine* e)
 
     // ## Test window undocking.
     t = IM_REGISTER_TEST(e, "docking", "docking_undock_tabs_and_nodes");
+    t->Flags |= ImGuiTestFlags_RequireAppWindows;
     t->GuiFunc = [](ImGuiTestContext* ctx)
     {
         for (int i = 0; i < 4; i++)
@@ -23,10 +23,32 @@
 // In your own application you may want to implement them using your own facilities (own thread or coroutine)
 #define IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL 1
 
+// Compile coroutine implementation using ucontext on Linux: it is much cheaper to switch to than a thread. std::thread remains the default, use '-coroutine ucontext' to select it.
+// AddressSanitizer doesn't support stack switching well, so we don't compile it there.
+#if defined(__linux__) && !defined(__SANITIZE_ADDRESS__)
+#define IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL 1
+#endif
+
 // Enable plotting of perflog data for comparing performance of different runs. This feature requires ImPlot.
 #ifndef IMGUI_TEST_ENGINE_ENABLE_IMPLOT
 #define IMGUI_TEST_ENGINE_ENABLE_IMPLOT 1
 #endif
 
+// Make the dear imgui (and implot) current context pointers thread-local, so '-jobs N' can run N contexts on their own threads.
+// The variables are defined in main.cpp. Disabled by default as every GImGui access becomes a TLS access: build with 'make IMGUI_TESTS_THREAD_LOCAL_CONTEXT=1' to enable -jobs.
+#ifndef IMGUI_TESTS_THREAD_LOCAL_CONTEXT
+#define IMGUI_TESTS_THREAD_LOCAL_CONTEXT 0
+#endif
+#if IMGUI_TESTS_THREAD_LOCAL_CONTEXT
+struct ImGuiContext;
+extern thread_local ImGuiContext* GImGuiThreadLocal;
+#define GImGui GImGuiThreadLocal
+#if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
+struct ImPlotContext;
+extern thread_local ImPlotContext* GImPlotThreadLocal;
+#define GImPlot GImPlotThreadLocal
+#endif
+#endif
+
 // Use relative path as this file may be compiled with different settings
 #include "../imgui_test_engine/imgui_te_imconfig.h"
@@ -47,6 +47,7 @@ void RegisterTests_Nav(ImGuiTestEngine* e)
     // ## Test opening a new window from a checkbox setting the focus to the new window.
     // In 9ba2028 (2019/01/04) we fixed a bug where holding ImGuiNavInputs_Activate too long on a button would hold the focus on the wrong window.
     t = IM_REGISTER_TEST(e, "nav", "nav_basic");
+    t->Flags |= ImGuiTestFlags_RequireAppWindows;
     t->TestFunc = [](ImGuiTestContext* ctx)
     {
         ctx->SetInputMode(ImGuiInputSource_Nav);
@@ -281,6 +282,7 @@ void RegisterTests_Nav(ImGuiTestEngine* e)
 
     // ## Test vertical wrap-around in menus/popups
     t = IM_REGISTER_TEST(e, "nav", "nav_menu_wraparound");
+    t->Flags |= ImGuiTestFlags_RequireAppWindows;
     t->TestFunc = [](ImGuiTestContext* ctx)
     {
         ImGuiContext& g = *ctx->UiContext;
@@ -769,6 +771,7 @@ void RegisterTests_Nav(ImGuiTestEngine* e)
 
     // ## Test NavID restoration after activating menu item.
     t = IM_REGISTER_TEST(e, "nav", "nav_focus_restore_menu");
+    t->Flags |= ImGuiTestFlags_RequireAppWindows;
     t->TestFunc = [](ImGuiTestContext* ctx)
     {
         ImGuiContext& g = *ctx->UiContext;
@@ -819,6 +822,7 @@ void RegisterTests_Nav(ImGuiTestEngine* e)
 
     // ## Test loss of navigation focus when clicking on empty viewport space (#3344).
     t = IM_REGISTER_TEST(e, "nav", "nav_focus_clear_on_void");
+    t->Flags |= ImGuiTestFlags_RequireAppWindows;
     t->TestFunc = [](ImGuiTestContext* ctx)
     {
         ImGuiContext& g = *ctx->UiContext;
@@ -1137,6 +1141,7 @@ void RegisterTests_Nav(ImGuiTestEngine* e)
 
     // ## Check nav keyboard/mouse highlight flags
     t = IM_REGISTER_TEST(e, "nav", "nav_highlight");
+    t->Flags |= ImGuiTestFlags_RequireAppWindows;
     t->TestFunc = [](ImGuiTestContext* ctx)
     {
         ImGuiContext& g = *ctx->UiContext;
@@ -3,12 +3,14 @@
 
 #define _CRT_SECURE_NO_WARNINGS
 #include <limits.h>
+#include <chrono>                                     // std::chrono::steady_clock (coroutine switch latency)
 #include "imgui.h"
 #define IMGUI_DEFINE_MATH_OPERATORS
 #include "imgui_internal.h"
 #include "imgui_tests.h"
 #include "imgui_test_engine/imgui_te_engine.h"      // IM_REGISTER_TEST()
 #include "imgui_test_engine/imgui_te_context.h"
+#include "imgui_test_engine/imgui_te_coroutine.h"    // Coroutine_ImplXXX_GetInterface()
 #include "imgui_test_engine/thirdparty/Str/Str.h"
 
 // Warnings
@@ -1119,5 +1121,244 @@ void RegisterTests_Perf(ImGuiTestEngine* e)
             }
         }
     }
+
+    // ## Measure the cost of test engine hooks while many item info queries are active
+    // Each variant keeps a different number of info tasks alive: the cost per frame should stay roughly the same.
+    // The _0000 variant keeps hooks disabled and serves as a baseline for hook overhead (compare with _0001).
+    // The _nofilter variants run with IO.ConfigInfoTasksFilter disabled, to measure the benefit of the filter itself.
+    auto StressHookInfoTasksFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::Begin("Test Func", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        int task_count = ctx->Test->ArgVariant;
+        int loop_count = ImMax(1000 * ctx->PerfStressAmount, task_count);
+        for (int n = 0; n < loop_count; n++)
+        {
+            ImGui::PushID(n);
+            ImGui::Button("Hello, world");
+            ImGui::PopID();
+            if (n < task_count)
+                ImGuiTestEngine_FindItemDebugLabel(ctx->UiContext, ImGui::GetItemID()); // Register or renew an info task
+        }
+        ImGui::End();
+    };
+    const int hook_info_task_counts[] = { 0, 1, 10, 100, 1000 };
+    for (int task_count : hook_info_task_counts)
+    {
+        t = IM_REGISTER_TEST(e, "perf", "");
+        t->SetOwnedName(Str64f("perf_stress_hook_info_tasks_%04d", task_count).c_str());
+        t->ArgVariant = task_count;
+        t->GuiFunc = StressHookInfoTasksFunc;
+        t->TestFunc = PerfCaptureFunc;
+        if (task_count == 0)
+            continue;
+
+        t = IM_REGISTER_TEST(e, "perf", "");
+        t->SetOwnedName(Str64f("perf_stress_hook_info_tasks_%04d_nofilter", task_count).c_str());
+        t->ArgVariant = task_count;
+        t->GuiFunc = StressHookInfoTasksFunc;
+        t->TestFunc = [](ImGuiTestContext* ctx)
+        {
+            const bool backup_filter = ctx->EngineIO->ConfigInfoTasksFilter;
+            ctx->EngineIO->ConfigInfoTasksFilter = false;
+            ctx->PerfCapture();
+            ctx->EngineIO->ConfigInfoTasksFilter = backup_filter;
+        };
+    }
+
+    // ## Measure the cost of compiling a test filter and matching it against 100k synthetic test names
+    t = IM_REGISTER_TEST(e, "perf", "perf_misc_test_filter_100k");
+    struct TestFilterVars { ImVector<char> Names; ImVector<int> NameOffsets; int MatchCount = 0; };
+    t->SetVarsDataType<TestFilterVars>();
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        TestFilterVars& vars = ctx->GetVars<TestFilterVars>();
+        if (vars.NameOffsets.Size == 0)
+        {
+            const char* categories[] = { "nav", "table", "widgets", "window", "docking", "misc", "inputs", "viewport" };
+            for (int n = 0; n < 100000; n++)
+            {
+                Str64f name("%s_%s_%05d%s", categories[n % IM_ARRAYSIZE(categories)], (n & 1) ? "scroll" : "resize", n, (n % 3) ? "" : "_basic");
+                vars.NameOffsets.push_back(vars.Names.Size);
+                vars.Names.insert(vars.Names.end(), name.c_str(), name.c_str() + name.length() + 1);
+            }
+        }
+
+        ImGui::Begin("Test Func", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        const int loop_count = ctx->PerfStressAmount;
+        for (int loop_n = 0; loop_n < loop_count; loop_n++)
+        {
+            ImGuiTestFilter filter("tests,-scroll,-^nav_,table*resize,_basic$,-^window_?_");
+            vars.MatchCount = 0;
+            for (int offset : vars.NameOffsets)
+                if (filter.PassFilter(vars.Names.Data + offset, ImGuiTestGroup_Tests))
+                    vars.MatchCount++;
+        }
+        ImGui::Text("%d/%d names matched", vars.MatchCount, vars.NameOffsets.Size);
+        ImGui::End();
+    };
+    t->TestFunc = PerfCaptureFunc;
+
+    // ## Measure the cost of registering 20k synthetic tests across 200 source files, as done on application startup
+    t = IM_REGISTER_TEST(e, "perf", "perf_misc_register_tests_20k");
+    struct RegisterTestsVars { ImVector<char> FileNames; ImU64 Duration = 0; };
+    t->SetVarsDataType<RegisterTestsVars>();
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        RegisterTestsVars& vars = ctx->GetVars<RegisterTestsVars>();
+        const int file_count = 200;
+        const int tests_per_file = 100;
+        if (vars.FileNames.Size == 0)
+        {
+            vars.FileNames.resize(file_count * 32);
+            for (int file_n = 0; file_n < file_count; file_n++)
+                ImFormatString(vars.FileNames.Data + file_n * 32, 32, "imgui_tests_synthetic_%03d.cpp", file_n);
+        }
+
+        const ImU64 start_time = ImTimeGetInMicroseconds();
+        for (int loop_n = 0; loop_n < ctx->PerfStressAmount; loop_n++)
+        {
+            ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+            ImGuiTestEngine_GetIO(engine).ConfigSavedSettings = false;
+            for (int test_n = 0; test_n < tests_per_file; test_n++)
+                for (int file_n = 0; file_n < file_count; file_n++)
+                    ImGuiTestEngine_RegisterTest(engine, "synthetic", "synthetic", vars.FileNames.Data + file_n * 32, 1 + (test_n * 37) % (tests_per_file * 10));
+            ImGuiTestEngine_CalcSourceLineEnds(engine);
+            ImGuiTestEngine_DestroyContext(engine);
+        }
+        vars.Duration = ImTimeGetInMicroseconds() - start_time;
+
+        ImGui::Begin("Test Func", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::Text("%d tests registered in %.3f ms", file_count * tests_per_file, vars.Duration / 1000.0 / ctx->PerfStressAmount);
+        ImGui::End();
+    };
+    t->TestFunc = PerfCaptureFunc;
+
+    // ## Measure the cost of ImGuiTestEngine_RestoreUiSnapshot() (used before each test with -restore-ui), compared to ImGuiTestEngine_RebootUiContext()
+    // Both are measured once from the TestFunc. As rebooting stops the engine, it is measured on a throwaway context and engine sharing the same font atlas.
+    // That context is empty, so the comparison is in favor of the reboot.
+    t = IM_REGISTER_TEST(e, "perf", "perf_misc_ui_snapshot_restore");
+    struct UiSnapshotRestoreVars { int LoopCount = 0; ImU64 RestoreDuration = 0; ImU64 RebootDuration = 0; };
+    t->SetVarsDataType<UiSnapshotRestoreVars>();
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        UiSnapshotRestoreVars& vars = ctx->GetVars<UiSnapshotRestoreVars>();
+        ImGui::Begin("Test Func", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::Text("Snapshot restore: %.3f ms", vars.LoopCount > 0 ? vars.RestoreDuration / 1000.0 / vars.LoopCount : 0.0);
+        ImGui::Text("Context reboot: %.3f ms", vars.RebootDuration / 1000.0);
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        UiSnapshotRestoreVars& vars = ctx->GetVars<UiSnapshotRestoreVars>();
+        ctx->Yield();
+
+        // Restore (averaged over multiple calls)
+        vars.LoopCount = 10 * ctx->PerfStressAmount;
+        if (!ctx->EngineIO->ConfigRestoreUiSnapshot) // Otherwise reuse snapshot captured before running queued tests
+            ImGuiTestEngine_CaptureUiSnapshot(ctx->Engine);
+        const ImU64 restore_start_time = ImTimeGetInMicroseconds();
+        for (int n = 0; n < vars.LoopCount; n++)
+            ImGuiTestEngine_RestoreUiSnapshot(ctx->Engine);
+        vars.RestoreDuration = ImTimeGetInMicroseconds() - restore_start_time;
+
+        // Reboot (once)
+        // Time the same DestroyContext()/CreateContext() sequence as ImGuiTestEngine_RebootUiContext(), on a throwaway context
+        // sharing our font atlas and holding our settings. Engine coroutine start/stop is excluded as restore doesn't pay for it.
+        ImGuiContext* backup_ui_ctx = ImGui::GetCurrentContext();
+        ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+        const float backup_settings_dirty_timer = backup_ui_ctx->SettingsDirtyTimer;
+        const char* ini_data = ImGui::SaveIniSettingsToMemory();
+        backup_ui_ctx->SettingsDirtyTimer = backup_settings_dirty_timer; // Don't mark our settings as saved
+        ImGuiContext* reboot_ui_ctx = ImGui::CreateContext(atlas);
+        ImGui::SetCurrentContext(reboot_ui_ctx);
+        ImGui::GetIO().IniFilename = NULL;
+        ImGui::LoadIniSettingsFromMemory(ini_data);
+        const ImU64 reboot_start_time = ImTimeGetInMicroseconds();
+        ImGui::DestroyContext(reboot_ui_ctx);
+        reboot_ui_ctx = ImGui::CreateContext(atlas);
+        vars.RebootDuration = ImTimeGetInMicroseconds() - reboot_start_time;
+        ImGui::DestroyContext(reboot_ui_ctx);
+        ImGui::SetCurrentContext(backup_ui_ctx);
+
+        const double restore_ms = vars.RestoreDuration / 1000.0 / vars.LoopCount;
+        const double reboot_ms = vars.RebootDuration / 1000.0;
+        ctx->LogInfo("[PERF] Snapshot restore: %.3f ms", restore_ms);
+        ctx->LogInfo("[PERF] Context reboot: %.3f ms (x%.1f)", reboot_ms, restore_ms > 0.0 ? reboot_ms / restore_ms : 0.0);
+        ctx->Yield();
+    };
+
+    // ## Measure the cost of switching between a coroutine and its caller, for each coroutine implementation
+    // Measured once from the TestFunc: a single coroutine yields 10000*PerfStressAmount times, and we report p50/p99 latency of a Run()+Yield() round-trip.
+    struct CoroutineSwitchVars { ImGuiTestCoroutineInterface* Funcs = NULL; int YieldCount = 0; ImU64 Duration = 0; double SwitchesPerSecond = 0.0; ImU32 LatencyP50 = 0, LatencyP99 = 0, LatencyMax = 0; };
+    auto CoroutineSwitchGuiFunc = [](ImGuiTestContext* ctx)
+    {
+        CoroutineSwitchVars& vars = ctx->GetVars<CoroutineSwitchVars>();
+        ImGui::Begin("Test Func", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_AlwaysAutoResize);
+        ImGui::Text("%d switches in %.3f ms (%.0f switches/sec)", vars.YieldCount * 2, vars.Duration / 1000.0, vars.SwitchesPerSecond);
+        ImGui::Text("Round-trip latency: p50 %u ns, p99 %u ns, max %u ns", vars.LatencyP50, vars.LatencyP99, vars.LatencyMax);
+        ImGui::End();
+    };
+    auto CoroutineSwitchTestFunc = [](ImGuiTestContext* ctx)
+    {
+        CoroutineSwitchVars& vars = ctx->GetVars<CoroutineSwitchVars>();
+        vars.YieldCount = 10000 * ctx->PerfStressAmount;
+        auto coroutine_main = [](void* data)
+        {
+            CoroutineSwitchVars& vars = *(CoroutineSwitchVars*)data;
+            for (int n = 0; n < vars.YieldCount; n++)
+                vars.Funcs->YieldFunc();
+        };
+
+        // Running a coroutine from the test coroutine is supported by all implementations.
+        ImVector<ImU32> samples;
+        samples.reserve(vars.YieldCount + 1);
+        const ImU64 start_time = ImTimeGetInMicroseconds();
+        ImGuiTestCoroutineHandle handle = vars.Funcs->CreateFunc(coroutine_main, "Perf Coroutine", &vars);
+        while (true)
+        {
+            const auto t0 = std::chrono::steady_clock::now();
+            const bool running = vars.Funcs->RunFunc(handle);
+            const auto t1 = std::chrono::steady_clock::now();
+            samples.push_back((ImU32)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+            if (!running)
+                break;
+        }
+        vars.Funcs->DestroyFunc(handle);
+        vars.Duration = ImTimeGetInMicroseconds() - start_time;
+        vars.SwitchesPerSecond = (vars.YieldCount * 2) / (vars.Duration / 1000000.0);
+
+        // First Run() includes thread/stack startup and last one includes termination: only keep steady-state round-trips.
+        if (samples.Size > 2)
+        {
+            samples.erase(samples.begin());
+            samples.pop_back();
+        }
+        ImQsort(samples.Data, (size_t)samples.Size, sizeof(ImU32), [](const void* lhs, const void* rhs) { ImU32 a = *(const ImU32*)lhs, b = *(const ImU32*)rhs; return (a < b) ? -1 : (a > b) ? +1 : 0; });
+        vars.LatencyP50 = samples.Size ? samples[samples.Size * 50 / 100] : 0;
+        vars.LatencyP99 = samples.Size ? samples[samples.Size * 99 / 100] : 0;
+        vars.LatencyMax = samples.Size ? samples.back() : 0;
+
+        ctx->LogInfo("[PERF] %d switches in %.3f ms (%.0f switches/sec)", vars.YieldCount * 2, vars.Duration / 1000.0, vars.SwitchesPerSecond);
+        ctx->LogInfo("[PERF] Round-trip latency: p50 %u ns, p99 %u ns, max %u ns", vars.LatencyP50, vars.LatencyP99, vars.LatencyMax);
+        ctx->Yield();
+    };
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+    t = IM_REGISTER_TEST(e, "perf", "perf_misc_coroutine_switch_stdthread");
+    t->SetVarsDataType<CoroutineSwitchVars>([](CoroutineSwitchVars& vars) { vars.Funcs = Coroutine_ImplStdThread_GetInterface(); });
+    t->GuiFunc = CoroutineSwitchGuiFunc;
+    t->TestFunc = CoroutineSwitchTestFunc;
+#if defined(__linux__)
+    t = IM_REGISTER_TEST(e, "perf", "perf_misc_coroutine_switch_stdthread_futex");
+    t->SetVarsDataType<CoroutineSwitchVars>([](CoroutineSwitchVars& vars) { vars.Funcs = Coroutine_ImplStdThreadFutex_GetInterface(); });
+    t->GuiFunc = CoroutineSwitchGuiFunc;
+    t->TestFunc = CoroutineSwitchTestFunc;
+#endif
+#endif
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+    t = IM_REGISTER_TEST(e, "perf", "perf_misc_coroutine_switch_ucontext");
+    t->SetVarsDataType<CoroutineSwitchVars>([](CoroutineSwitchVars& vars) { vars.Funcs = Coroutine_ImplUcontext_GetInterface(); });
+    t->GuiFunc = CoroutineSwitchGuiFunc;
+    t->TestFunc = CoroutineSwitchTestFunc;
+#endif
 }
 
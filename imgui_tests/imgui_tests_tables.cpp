@@ -3016,6 +3016,68 @@ void RegisterTests_Table(ImGuiTestEngine* e)
         ctx->MouseMove("table1/0");     // Ensure LastItemStatusFlags has _HoveredRect flag.
         ctx->Yield(2);                  // Do one more frame so tests in GuiFunc can run.
     };
+
+    // ## Test resolving wildcard references to rows clipped by a ImGuiListClipper, in a large table.
+    // Also measure how many frames and how much time it takes.
+    t = IM_REGISTER_TEST(e, "table", "table_ref_wildcard_clipper");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::SetNextWindowSize(ImVec2(300.0f, 300.0f), ImGuiCond_Appearing);
+        ImGui::Begin("Test window 1", NULL, ImGuiWindowFlags_NoSavedSettings);
+        if (ImGui::BeginTable("table1", 2, ImGuiTableFlags_ScrollY))
+        {
+            ImGuiListClipper clipper;
+            clipper.Begin(10000);
+            while (clipper.Step())
+                for (int row_n = clipper.DisplayStart; row_n < clipper.DisplayEnd; row_n++)
+                {
+                    ImGui::TableNextRow();
+                    ImGui::TableNextColumn();
+                    ImGui::PushID(row_n);
+                    if (ImGui::Button(Str16f("Row %d", row_n).c_str()))
+                        ctx->GenericVars.Int1 = row_n;
+                    ImGui::PopID();
+                    ImGui::TableNextColumn();
+                    ImGui::Text("%d", row_n);
+                }
+            ImGui::EndTable();
+        }
+        ImGui::End();
+
+        // Another clipper outside of the searched window: it should never be forced to display its full range.
+        ImGui::SetNextWindowSize(ImVec2(300.0f, 300.0f), ImGuiCond_Appearing);
+        ImGui::Begin("Test window 2", NULL, ImGuiWindowFlags_NoSavedSettings);
+        {
+            int rows_submitted = 0;
+            ImGuiListClipper clipper;
+            clipper.Begin(10000);
+            while (clipper.Step())
+                for (int row_n = clipper.DisplayStart; row_n < clipper.DisplayEnd; row_n++, rows_submitted++)
+                    ImGui::Button(Str16f("Row %d", row_n).c_str());
+            ctx->GenericVars.Int2 = ImMax(ctx->GenericVars.Int2, rows_submitted);
+        }
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ctx->SetRef("Test window 1");
+        ctx->GenericVars.Int2 = 0;
+        const int row_targets[] = { 5, 9876, 1234 };
+        for (int row_n : row_targets)
+        {
+            const int frame_count = ctx->FrameCount;
+            const ImU64 start_time = ImTimeGetInMicroseconds();
+            ImGuiTestItemInfo* item = ctx->ItemInfo(Str16f("**/Row %d", row_n).c_str());
+            const ImU64 end_time = ImTimeGetInMicroseconds();
+            IM_CHECK(item != NULL);
+            ctx->LogInfo("Row %d: found in %d frames, %.2f ms", row_n, ctx->FrameCount - frame_count, (end_time - start_time) / 1000.0);
+            IM_CHECK_LE(ctx->FrameCount - frame_count, 8);
+
+            ctx->ItemClick(Str16f("**/Row %d", row_n).c_str());
+            IM_CHECK_EQ(ctx->GenericVars.Int1, row_n);
+        }
+        IM_CHECK_LT(ctx->GenericVars.Int2, 100);
+    };
 }
 
 //-------------------------------------------------------------------------
@@ -3360,6 +3360,7 @@ void RegisterTests_Widgets(ImGuiTestEngine* e)
 
     // ## Test preserving g.ActiveId during drag operation opening tree items.
     t = IM_REGISTER_TEST(e, "widgets", "widgets_drag_hold_to_open");
+    t->Flags |= ImGuiTestFlags_RequireAppWindows;
     t->GuiFunc = [](ImGuiTestContext* ctx)
     {
         if (ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings))
@@ -3732,6 +3733,7 @@ void RegisterTests_Widgets(ImGuiTestEngine* e)
 
     // ## Test long text rendering in TextUnformatted()
     t = IM_REGISTER_TEST(e, "widgets", "widgets_text_long");
+    t->Flags |= ImGuiTestFlags_RequireAppWindows;
     t->TestFunc = [](ImGuiTestContext* ctx)
     {
         ctx->SetRef("Dear ImGui Demo");
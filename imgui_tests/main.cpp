@@ -12,6 +12,12 @@
 
 #define CMDLINE_ARGS  "-fileopener tools/win32_open_with_sublime.cmd"
 //#define CMDLINE_ARGS  "-nogui -export-format junit -export-file output/tests.junit.xml widgets_input"
+//#define CMDLINE_ARGS  "-nogui -nopause -shard 1/4 -shard-durations output/tests.junit.xml -export-file output/tests.shard1.junit.xml"
+//#define CMDLINE_ARGS  "-nogui -nopause -workers 4 -export-file output/tests.junit.xml"
+//#define CMDLINE_ARGS  "-nogui -nopause -isolate 1 -export-file output/tests.junit.xml"
+//#define CMDLINE_ARGS  "-nogui -server imgui_tests.sock"
+//#define CMDLINE_ARGS  "-nogui -nopause -changed-only -result-cache output/tests.cache"
+//#define CMDLINE_ARGS  "-merge-junit output/tests.junit.xml output/tests.shard1.junit.xml output/tests.shard2.junit.xml output/tests.shard3.junit.xml output/tests.shard4.junit.xml"
 //#define CMDLINE_ARGS  "-viewport-mock -nogui viewport_"               // Test mock viewports on TTY mode
 //#define CMDLINE_ARGS  "-gui -nothrottle"
 //#define CMDLINE_ARGS  "-slow widgets_inputtext_5_deactivate_flags"
@@ -66,6 +72,18 @@ static inline void DebugCrtDumpLeaks()
 #include "imgui_test_engine/imgui_te_ui.h"
 #include "imgui_test_engine/imgui_capture_tool.h"
 #include "imgui_test_engine/thirdparty/Str/Str.h"
+#include <thread>
+#ifndef _WIN32
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
 
 // imgui_app
 #ifndef IMGUI_APP_IMPLEMENTATION
@@ -78,6 +96,14 @@ static inline void DebugCrtDumpLeaks()
 #include "thirdparty/implot/implot.h"
 #endif
 
+// Current context pointers, made thread-local by imgui_tests_imconfig.h so each '-jobs' thread may use its own contexts.
+#if IMGUI_TESTS_THREAD_LOCAL_CONTEXT
+thread_local ImGuiContext* GImGuiThreadLocal = NULL;
+#if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
+thread_local ImPlotContext* GImPlotThreadLocal = NULL;
+#endif
+#endif
+
 //-------------------------------------------------------------------------
 // Allocators
 //-------------------------------------------------------------------------
@@ -90,12 +116,14 @@ static void    FreeWrapper(void* ptr, void* user_data)        { IM_UNUSED(user_d
 //-------------------------------------------------------------------------
 
 struct ImGuiApp;
+struct TestAppServer;
 
 struct TestApp
 {
     bool                    Quit = false;
     ImGuiApp*               AppWindow = NULL;
     ImGuiTestEngine*        TestEngine = NULL;
+    TestAppServer*          Server = NULL;
     ImU64                   LastTime = 0;
     ImVec4                  ClearColor = ImVec4(0.45f, 0.55f, 0.60f, 1.00f);
 
@@ -110,29 +138,51 @@ struct TestApp
     bool                    OptViewports = false;
     bool                    OptMockViewports = false;
     int                     OptStressAmount = 5;
+    bool                    OptNoInfoTasksFilter = false;                       // See ImGuiTestEngineIO::ConfigInfoTasksFilter
     Str128                  OptSourceFileOpener;
     Str128                  OptExportFilename;
+    Str32                   OptCoroutineImpl;                                   // Empty = default (see ImGuiTestEngine constructor)
+    int                     OptTurboFrames = 0;                                 // Extra frames per application frame (see ImGuiTestEngineIO::ConfigTurboFrames)
+    float                   OptFixedDeltaTime = 0.0f;                           // Fixed delta time (see ImGuiTestEngineIO::ConfigFixedDeltaTime)
+    bool                    OptRestoreUi = false;                               // Restore UI context snapshot before each test (see ImGuiTestEngineIO::ConfigRestoreUiSnapshot)
+    int                     OptJobs = 1;                                        // Number of threads running tests in parallel, each with its own context (command-line mode only)
+    int                     OptIsolate = 0;                                     // Number of tests per forked child of a warmed-up process, 0 = disabled (command-line mode only, POSIX only)
+    int                     OptWorkers = 0;                                     // Number of worker processes pulling tests from a shared queue, 0 = disabled (command-line mode only, POSIX only)
+    int                     OptShardIndex = 0;                                  // Shard to run (see ImGuiTestEngineIO::ConfigShardIndex). 0-based, while -shard argument is 1-based.
+    int                     OptShardCount = 1;
+    Str128                  OptShardDurationsFilename;                          // JUnit XML file of a previous run, to balance shards by duration
+    Str128                  OptResultCacheFilename;                             // Results of previous runs, loaded before queuing tests and updated after running them
+    Str64                   OptBuildId;                                         // See ImGuiTestEngineIO::BuildId
+    Str64                   BuildId;                                            // OptBuildId, or hash of dear imgui and test engine sources by default
+    bool                    OptChangedOnly = false;                             // Skip tests which passed in a previous run with same source and build (see ImGuiTestEngineIO::ConfigQueueChangedOnly)
+    Str128                  OptServerSocketPath;                                // Stay alive and accept commands on this local socket (POSIX only)
+    Str128                  OptMergeJUnitFilename;                              // Merge JUnit XML files passed as arguments into this file, then exit
     ImGuiTestEngineExportFormat OptExportFormat = ImGuiTestEngineExportFormat_JUnitXml;
     ImVector<char*>         TestsToRun;
+    Str64                   GitBranchName;
 };
 
 TestApp g_App;
 
-static void ShowUI()
+// Cleared on all '-jobs' threads but the first one: imgui_demo.cpp keeps its state in static variables so only one thread may call ShowDemoWindow().
+static thread_local bool g_AllowDemoWindow = true;
+
+static void ShowUI(ImGuiTestEngine* engine)
 {
-    ImGuiTestEngine_ShowTestEngineWindows(g_App.TestEngine, NULL);
+    ImGuiTestEngine_ShowTestEngineWindows(engine, NULL);
 
-    static bool show_demo_window = true;
-    static bool show_another_window = false;
+    // (using thread_local as each '-jobs' thread shows this in its own context)
+    static thread_local bool show_demo_window = true;
+    static thread_local bool show_another_window = false;
 
     // 1. Show the big demo window (Most of the sample code is in ImGui::ShowDemoWindow()! You can browse its code to learn more about Dear ImGui!).
-    if (show_demo_window)
+    if (show_demo_window && g_AllowDemoWindow)
         ImGui::ShowDemoWindow(&show_demo_window);
 
     // 2. Show a simple window that we create ourselves. We use a Begin/End pair to created a named window.
     {
-        static float f = 0.0f;
-        static int counter = 0;
+        static thread_local float f = 0.0f;
+        static thread_local int counter = 0;
 
         ImGui::Begin("Hello, world!");                          // Create a window called "Hello, world!" and append into it.
 
@@ -229,6 +279,10 @@ static bool ParseCommandLineOptions(int argc, char** argv)
                 g_App.OptStressAmount = atoi(argv[n + 1]);
                 n++;
             }
+            else if (strcmp(argv[n], "-no-info-tasks-filter") == 0)
+            {
+                g_App.OptNoInfoTasksFilter = true;
+            }
             else if (strcmp(argv[n], "-fileopener") == 0 && n + 1 < argc)
             {
                 g_App.OptSourceFileOpener = argv[n + 1];
@@ -247,10 +301,93 @@ static bool ParseCommandLineOptions(int argc, char** argv)
                     fprintf(stderr, "Possible values:\n");
                     fprintf(stderr, "- junit\n");
                 }
+                n++;
             }
             else if (strcmp(argv[n], "-export-file") == 0 && n + 1 < argc)
             {
                 g_App.OptExportFilename = argv[n + 1];
+                n++;
+            }
+            else if (strcmp(argv[n], "-coroutine") == 0 && n + 1 < argc)
+            {
+                g_App.OptCoroutineImpl = argv[n + 1];
+                n++;
+            }
+            else if (strcmp(argv[n], "-turbo") == 0 && n + 1 < argc)
+            {
+                g_App.OptTurboFrames = atoi(argv[n + 1]);
+                n++;
+            }
+            else if (strcmp(argv[n], "-fixed-dt") == 0 && n + 1 < argc)
+            {
+                g_App.OptFixedDeltaTime = (float)atof(argv[n + 1]);
+                n++;
+            }
+            else if (strcmp(argv[n], "-restore-ui") == 0)
+            {
+                g_App.OptRestoreUi = true;
+            }
+            else if (strcmp(argv[n], "-jobs") == 0 && n + 1 < argc)
+            {
+                g_App.OptJobs = atoi(argv[n + 1]);
+                if (g_App.OptJobs <= 0)
+                    g_App.OptJobs = (int)std::thread::hardware_concurrency();
+                n++;
+            }
+            else if (strcmp(argv[n], "-isolate") == 0 && n + 1 < argc)
+            {
+                g_App.OptIsolate = ImMax(1, atoi(argv[n + 1]));
+                n++;
+            }
+            else if (strcmp(argv[n], "-workers") == 0 && n + 1 < argc)
+            {
+                g_App.OptWorkers = atoi(argv[n + 1]);
+                if (g_App.OptWorkers <= 0)
+                    g_App.OptWorkers = ImMax(1, (int)std::thread::hardware_concurrency());
+                n++;
+            }
+            else if (strcmp(argv[n], "-shard") == 0 && n + 1 < argc)
+            {
+                int shard_number = 0, shard_count = 0;
+                if (sscanf(argv[n + 1], "%d/%d", &shard_number, &shard_count) == 2 && shard_count >= 1 && shard_number >= 1 && shard_number <= shard_count)
+                {
+                    g_App.OptShardIndex = shard_number - 1;
+                    g_App.OptShardCount = shard_count;
+                }
+                else
+                {
+                    fprintf(stderr, "Invalid value '%s' passed to '-shard', expected <index>/<count> with 1 <= index <= count.\n", argv[n + 1]);
+                }
+                n++;
+            }
+            else if (strcmp(argv[n], "-shard-durations") == 0 && n + 1 < argc)
+            {
+                g_App.OptShardDurationsFilename = argv[n + 1];
+                n++;
+            }
+            else if (strcmp(argv[n], "-result-cache") == 0 && n + 1 < argc)
+            {
+                g_App.OptResultCacheFilename = argv[n + 1];
+                n++;
+            }
+            else if (strcmp(argv[n], "-build-id") == 0 && n + 1 < argc)
+            {
+                g_App.OptBuildId = argv[n + 1];
+                n++;
+            }
+            else if (strcmp(argv[n], "-changed-only") == 0)
+            {
+                g_App.OptChangedOnly = true;
+            }
+            else if (strcmp(argv[n], "-server") == 0 && n + 1 < argc)
+            {
+                g_App.OptServerSocketPath = argv[n + 1];
+                n++;
+            }
+            else if (strcmp(argv[n], "-merge-junit") == 0 && n + 1 < argc)
+            {
+                g_App.OptMergeJUnitFilename = argv[n + 1];
+                n++;
             }
             else if (strcmp(argv[n], "--") == 0)
             {
@@ -270,9 +407,24 @@ static bool ParseCommandLineOptions(int argc, char** argv)
                 printf("  -nothrottle              : run GUI app without throttling/vsync by default.\n");
                 printf("  -nopause                 : don't pause application on exit.\n");
                 printf("  -stressamount <int>      : set performance test duration multiplier (default: 5)\n");
+                printf("  -no-info-tasks-filter    : disable bloom filter in item hooks, to compare performance tests with and without it.\n");
                 printf("  -fileopener <file>       : provide a bat/cmd/shell script to open source file.\n");
                 printf("  -export-file <file>      : save test run results in specified file.\n");
                 printf("  -export-format <format>   : save test run results in specified format. (default: junit)\n");
+                printf("  -coroutine <impl>        : coroutine implementation: stdthread (default), stdthread-futex, ucontext (when compiled in).\n");
+                printf("  -turbo <int>             : in fast mode, run up to <int> extra frames per rendered frame (default: 0).\n");
+                printf("  -fixed-dt <float>        : use fixed delta time (in seconds, e.g. 0.016) instead of wall clock. Deterministic with -nogui.\n");
+                printf("  -restore-ui              : restore windows/tables/docking state captured before the first test, before each test.\n");
+                printf("  -jobs <int>              : run tests on <int> threads in parallel, each with its own context (0: one per core). Requires -nogui and a build with IMGUI_TESTS_THREAD_LOCAL_CONTEXT=1.\n");
+                printf("  -isolate <int>           : run each batch of <int> tests in a forked child of a warmed-up process, a crash only fails one test. Requires -nogui.\n");
+                printf("  -workers <int>           : run tests in <int> worker processes pulling from a shared queue (0: one per core). Requires -nogui.\n");
+                printf("  -shard <index>/<count>   : only run shard <index> (1-based) out of <count> shards of similar duration.\n");
+                printf("  -shard-durations <file>  : balance shards using test durations from JUnit XML file of a previous run (e.g. merged results).\n");
+                printf("  -result-cache <file>     : load results of previous runs from <file>, and update it with results of this run.\n");
+                printf("  -changed-only            : skip tests which passed in a previous run with same test source and build (default cache: imgui_tests.cache).\n");
+                printf("  -build-id <string>       : identify the build in result cache (e.g. git commit + dirty state). Default: hash of dear imgui and test engine sources.\n");
+                printf("  -server <socket_path>    : stay alive and run tests queued by commands received on local socket (see 'queue', 'results', 'quit').\n");
+                printf("  -merge-junit <file>      : merge JUnit XML files of shards passed as arguments into <file>, then exit.\n");
                 printf("Tests:\n");
                 printf("   all/tests/perf          : queue by groups: all, only tests, only performance benchmarks.\n");
                 printf("   [pattern]               : queue all tests containing the word [pattern].\n");
@@ -342,6 +494,49 @@ static void LoadFonts(float dpi_scale)
     io.Fonts->Build();
 }
 
+static ImGuiTestRunFlags GetTestRunFlags()
+{
+    ImGuiTestRunFlags run_flags = ImGuiTestRunFlags_CommandLine;
+    if (g_App.OptGuiFunc)
+        run_flags |= ImGuiTestRunFlags_GuiFuncOnly;
+    return run_flags;
+}
+
+// Default build id for the result cache: hash of dear imgui, test engine and configuration sources.
+// Tests are covered by their own source hash, so editing a test doesn't invalidate other cache entries.
+// Changes to code shared by tests outside of their own source lines (e.g. helpers in imgui_tests.h, or the application) are NOT detected:
+// pass '-build-id' from your build system (e.g. git commit + dirty state) if they need to be.
+// Like test sources (see ImGuiTestEngine_CalcSourceHashes()), paths derive from __FILE__ so relative ones are resolved from the working directory.
+#ifndef IMGUI_TESTS_IMGUI_DIR
+#define IMGUI_TESTS_IMGUI_DIR   "../../imgui/"  // Relative to imgui_tests/
+#endif
+static bool CalcSourcesBuildId(Str* out_build_id)
+{
+    const char* source_files[] =
+    {
+        IMGUI_TESTS_IMGUI_DIR "imgui.h", IMGUI_TESTS_IMGUI_DIR "imgui_internal.h", IMGUI_TESTS_IMGUI_DIR "imgui.cpp", IMGUI_TESTS_IMGUI_DIR "imgui_demo.cpp",
+        IMGUI_TESTS_IMGUI_DIR "imgui_draw.cpp", IMGUI_TESTS_IMGUI_DIR "imgui_tables.cpp", IMGUI_TESTS_IMGUI_DIR "imgui_widgets.cpp",
+        "../imgui_test_engine/imgui_te_context.cpp", "../imgui_test_engine/imgui_te_context.h", "../imgui_test_engine/imgui_te_engine.cpp", "../imgui_test_engine/imgui_te_engine.h",
+        "../imgui_test_engine/imgui_te_internal.h", "../imgui_test_engine/imgui_te_utils.cpp", "../imgui_test_engine/imgui_te_imconfig.h",
+        "imgui_tests_imconfig.h",
+    };
+    Str256 base_dir;
+    base_dir.set(__FILE__, ImPathFindFilename(__FILE__));
+    ImGuiID hash = 0;
+    for (const char* source_file : source_files)
+    {
+        Str256f path("%s%s", base_dir.c_str(), source_file);
+        size_t size = 0;
+        void* data = ImFileLoadToMemory(path.c_str(), "rb", &size);
+        if (data == NULL)
+            return false;
+        hash = ImHashData(data, size, hash);
+        IM_FREE(data);
+    }
+    out_build_id->setf("src-%08X", hash);
+    return true;
+}
+
 static void QueueTests(ImGuiTestEngine* engine)
 {
     // Non-interactive mode queue all tests by default
@@ -349,9 +544,22 @@ static void QueueTests(ImGuiTestEngine* engine)
         g_App.TestsToRun.push_back(strdup("tests"));
 
     // Queue requested tests
-    ImGuiTestRunFlags run_flags = ImGuiTestRunFlags_CommandLine;
-    if (g_App.OptGuiFunc)
-        run_flags |= ImGuiTestRunFlags_GuiFuncOnly;
+    ImGuiTestRunFlags run_flags = GetTestRunFlags();
+
+    // Sharding: ImGuiTestEngine_QueueTests() only queues tests of our shard, partitioned using durations of a previous run when available
+    ImGuiTestEngineIO& test_io = ImGuiTestEngine_GetIO(engine);
+    test_io.ConfigShardIndex = g_App.OptShardIndex;
+    test_io.ConfigShardCount = g_App.OptShardCount;
+    if (g_App.OptShardCount > 1 && !g_App.OptShardDurationsFilename.empty())
+        if (!ImGuiTestEngine_ImportDurationsFromJUnitXml(engine, g_App.OptShardDurationsFilename.c_str()))
+            fprintf(stderr, "Reading test durations from '%s' failed, shards will be balanced by test count.\n", g_App.OptShardDurationsFilename.c_str());
+
+    // Result cache: ImGuiTestEngine_QueueTests() skips tests which passed in a previous run, unless their source or the build changed
+    test_io.ConfigQueueChangedOnly = g_App.OptChangedOnly;
+    ImStrncpy(test_io.BuildId, g_App.BuildId.c_str(), IM_ARRAYSIZE(test_io.BuildId));
+    if (!g_App.OptResultCacheFilename.empty())
+        if (!ImGuiTestEngine_LoadResultCache(engine, g_App.OptResultCacheFilename.c_str()) && g_App.OptChangedOnly)
+            fprintf(stderr, "Reading result cache '%s' failed, running all tests.\n", g_App.OptResultCacheFilename.c_str());
 
     // Special groups are supported by ImGuiTestEngine_QueueTests(): "all", "tests", "perfs"
     // Following command line examples are functionally identical:
@@ -391,72 +599,18 @@ static void FindVideoEncoder(char* out, int out_len)
         *out = 0;
 }
 
-int main(int argc, char** argv)
+// Create Dear ImGui context (+ ImPlot context) and make it current
+static ImGuiContext* CreateImGuiContext(const char* ini_filename)
 {
-#ifdef DEBUG_CRT
-    DebugCrtInit(0);
-#endif
-
-    // Parse command-line arguments
-#if defined(IMGUI_APP_WIN32_DX11) || defined(IMGUI_APP_SDL_GL2) || defined(IMGUI_APP_SDL_GL3) || defined(IMGUI_APP_GLFW_GL3)
-    g_App.OptGui = true;
-#endif
-
-#ifdef CMDLINE_ARGS
-    if (argc == 1)
-    {
-        printf("# [exe] %s\n", CMDLINE_ARGS);
-        ImParseExtractArgcArgvFromCommandLine(&argc, (const char***)&argv, CMDLINE_ARGS);
-        if (!ParseCommandLineOptions(argc, argv))
-            return ImGuiTestAppErrorCode_CommandLineError;
-        free(argv);
-    }
-    else
-#endif
-    {
-        if (!ParseCommandLineOptions(argc, argv))
-            return ImGuiTestAppErrorCode_CommandLineError;
-    }
-    argv = NULL;
-
-    // Default verbose levels differs whether we are in in GUI or Command-Line mode
-    if (g_App.OptGui)
-    {
-        // Default -v4 -ve4
-        if (g_App.OptVerboseLevelBasic == ImGuiTestVerboseLevel_COUNT)
-            g_App.OptVerboseLevelBasic = ImGuiTestVerboseLevel_Debug;
-        if (g_App.OptVerboseLevelError == ImGuiTestVerboseLevel_COUNT)
-            g_App.OptVerboseLevelError = ImGuiTestVerboseLevel_Debug;
-    }
-    else
-    {
-        // Default -v2 -ve4
-        if (g_App.OptVerboseLevelBasic == ImGuiTestVerboseLevel_COUNT)
-            g_App.OptVerboseLevelBasic = ImGuiTestVerboseLevel_Warning;
-        if (g_App.OptVerboseLevelError == ImGuiTestVerboseLevel_COUNT)
-            g_App.OptVerboseLevelError = ImGuiTestVerboseLevel_Debug;
-    }
-
-    // Custom allocator functions, only to test overriding of allocators.
-    ImGui::SetAllocatorFunctions(&MallocWrapper, &FreeWrapper, &g_App);
-    ImGuiMemAllocFunc alloc_func;
-    ImGuiMemFreeFunc free_func;
-    void* alloc_user_data;
-    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &alloc_user_data);
-    IM_ASSERT(alloc_func == &MallocWrapper);
-    IM_ASSERT(free_func == &FreeWrapper);
-    IM_ASSERT(alloc_user_data == &g_App);
-
-    // Setup Dear ImGui binding
-    IMGUI_CHECKVERSION();
-    ImGui::CreateContext();
+    ImGuiContext* ui_ctx = ImGui::CreateContext();
+    ImGui::SetCurrentContext(ui_ctx);
 #if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
     ImPlot::CreateContext();
 #endif
     ImGui::StyleColorsDark();
 
     ImGuiIO& io = ImGui::GetIO();
-    io.IniFilename = "imgui.ini";
+    io.IniFilename = ini_filename;
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;  // Enable Keyboard Controls
     //ImGuiStyle& style = ImGui::GetStyle();
     //style.Colors[ImGuiCol_Border] = style.Colors[ImGuiCol_BorderShadow] = ImVec4(1.0f, 0, 0, 1.0f);
@@ -470,30 +624,70 @@ int main(int argc, char** argv)
     io.ConfigFlags |= ImGuiConfigFlags_DockingEnable;
     //io.ConfigDockingTabBarOnSingleWindows = true;
 #endif
+    return ui_ctx;
+}
 
-    // Creates window
-    if (g_App.OptGui)
-        g_App.AppWindow = ImGuiApp_ImplDefault_Create();
-    if (g_App.AppWindow == NULL)
-        g_App.AppWindow = ImGuiApp_ImplNull_Create();
-    g_App.AppWindow->DpiAware = false;
-    g_App.AppWindow->MockViewports = g_App.OptViewports && g_App.OptMockViewports;
-
-    // Create TestEngine context
-    IM_ASSERT(g_App.TestEngine == NULL);
-    ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
-    g_App.TestEngine = engine;
+// IMPORTANT: we need to destroy the Dear ImGui context BEFORE the test engine context, so .ini data may be saved.
+static void DestroyImGuiContext(ImGuiContext* ui_ctx)
+{
+#if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
+    ImPlot::DestroyContext();
+#endif
+    ImGui::DestroyContext(ui_ctx);
+}
+
+static ImGuiApp* CreateAppWindow(bool gui)
+{
+    ImGuiApp* app_window = NULL;
+    if (gui)
+        app_window = ImGuiApp_ImplDefault_Create();
+    if (app_window == NULL)
+        app_window = ImGuiApp_ImplNull_Create();
+    app_window->DpiAware = false;
+    app_window->MockViewports = g_App.OptViewports && g_App.OptMockViewports;
+    app_window->FixedDeltaTime = g_App.OptFixedDeltaTime;
+    return app_window;
+}
 
-    // Apply options
+// Apply command-line options to test engine
+static void InitTestEngineIO(ImGuiTestEngine* engine, ImGuiApp* app_window)
+{
     ImGuiTestEngineIO& test_io = ImGuiTestEngine_GetIO(engine);
     test_io.ConfigRunSpeed = g_App.OptRunSpeed;
     test_io.ConfigVerboseLevel = g_App.OptVerboseLevelBasic;
     test_io.ConfigVerboseLevelOnError = g_App.OptVerboseLevelError;
     test_io.ConfigNoThrottle = g_App.OptNoThrottle;
     test_io.PerfStressAmount = g_App.OptStressAmount;
+    test_io.ConfigInfoTasksFilter = !g_App.OptNoInfoTasksFilter;
+    test_io.ConfigTurboFrames = g_App.OptTurboFrames;
+    test_io.ConfigFixedDeltaTime = g_App.OptFixedDeltaTime;
+    test_io.ConfigRestoreUiSnapshot = g_App.OptRestoreUi;
+    test_io.TurboAppGuiFunc = [](void* user_data) { ShowUI((ImGuiTestEngine*)user_data); };
+    test_io.TurboAppGuiUserData = (void*)engine;
+    if (!g_App.OptCoroutineImpl.empty())
+    {
+        ImGuiTestCoroutineInterface* coroutine_funcs = NULL;
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+        if (strcmp(g_App.OptCoroutineImpl.c_str(), "stdthread") == 0)
+            coroutine_funcs = Coroutine_ImplStdThread_GetInterface();
+#if defined(__linux__)
+        if (strcmp(g_App.OptCoroutineImpl.c_str(), "stdthread-futex") == 0)
+            coroutine_funcs = Coroutine_ImplStdThreadFutex_GetInterface();
+#endif
+#endif
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+        if (strcmp(g_App.OptCoroutineImpl.c_str(), "ucontext") == 0)
+            coroutine_funcs = Coroutine_ImplUcontext_GetInterface();
+#endif
+        if (coroutine_funcs != NULL)
+            test_io.CoroutineFuncs = coroutine_funcs;
+        else
+            fprintf(stderr, "Unknown or disabled coroutine implementation '%s', using default.\n", g_App.OptCoroutineImpl.c_str());
+    }
     FindVideoEncoder(test_io.VideoCaptureEncoderPath, IM_ARRAYSIZE(test_io.VideoCaptureEncoderPath));
     ImStrncpy(test_io.VideoCaptureEncoderParams, IMGUI_CAPTURE_DEFAULT_VIDEO_PARAMS_FOR_FFMPEG, IM_ARRAYSIZE(test_io.VideoCaptureEncoderParams));
     ImStrncpy(test_io.GifCaptureEncoderParams, IMGUI_CAPTURE_DEFAULT_GIF_PARAMS_FOR_FFMPEG, IM_ARRAYSIZE(test_io.GifCaptureEncoderParams));
+    ImStrncpy(test_io.GitBranchName, g_App.GitBranchName.c_str(), IM_ARRAYSIZE(test_io.GitBranchName));
 
     if (g_App.OptGui)
     {
@@ -519,61 +713,30 @@ int main(int argc, char** argv)
     test_io.SrcFileOpenFunc = g_App.OptSourceFileOpener.empty() ? NULL : SrcFileOpenerFunc;
     test_io.SrcFileOpenUserData = NULL;
     test_io.ScreenCaptureFunc = ImGuiApp_ScreenCaptureFunc;
-    test_io.ScreenCaptureUserData = (void*)g_App.AppWindow;
-
-    // Enable test result export
-    if (!g_App.OptExportFilename.empty())
-    {
-        if (!g_App.TestsToRun.empty())
-        {
-            test_io.ExportResultsFilename = g_App.OptExportFilename.c_str();
-            test_io.ExportResultsFormat = !g_App.OptExportFilename.empty() ? g_App.OptExportFormat : ImGuiTestEngineExportFormat_None;
-        }
-        else
-        {
-            fprintf(stderr, "-junit-xml parameter is ignored in interactive runs.");
-        }
-    }
-
-    // Create window
-    ImGuiApp* app_window = g_App.AppWindow;
-    app_window->InitCreateWindow(app_window, "Dear ImGui: Test Engine", ImVec2(1440, 900));
-    app_window->InitBackends(app_window);
-
-    // Register and queue our tests
-    RegisterTests(engine);
-    QueueTests(engine);
-    bool exit_after_tests = !ImGuiTestEngine_IsTestQueueEmpty(engine) && !g_App.OptPauseOnExit;
-
-    // Retrieve Git branch name, store in annotation field by default
-    Str64 git_repo_path;
-    Str64 git_branch;
-    if (ImFileFindInParents("imgui/", 4, &git_repo_path))
-        if (ImBuildGetGitBranchName(git_repo_path.c_str(), &git_branch))
-            strncpy(test_io.GitBranchName, git_branch.c_str(), IM_ARRAYSIZE(test_io.GitBranchName));
-    if (!test_io.GitBranchName[0])
-    {
-        strcpy(test_io.GitBranchName, "unknown");
-        fprintf(stderr, "Dear ImGui git repository was not found.\n");
-    }
-    printf("Git branch: \"%s\"\n", test_io.GitBranchName);
-
-    // Start engine
-    ImGuiTestEngine_Start(engine, ImGui::GetCurrentContext());
-    ImGuiTestEngine_InstallDefaultCrashHandler();
+    test_io.ScreenCaptureUserData = (void*)app_window;
+}
 
-    // Load fonts, Set DPI scale
-    LoadFonts(app_window->DpiScale);
-    ImGui::GetStyle().ScaleAllSizes(app_window->DpiScale);
-    //test_io.DpiScale = app_window->DpiScale;
+#ifndef _WIN32
+static void UpdateServer(TestAppServer* server, ImGuiTestEngine* engine);
+#endif
 
-    // Main loop
+// Run application until tests are done (command-line mode) or window is closed. Return true when aborted.
+static bool RunMainLoop(ImGuiTestEngine* engine, ImGuiApp* app_window, bool exit_after_tests)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    ImGuiTestEngineIO& test_io = ImGuiTestEngine_GetIO(engine);
     bool aborted = false;
     while (true)
     {
+#ifndef _WIN32
+        // Process commands of -server clients
+        if (g_App.Server != NULL && !aborted)
+            UpdateServer(g_App.Server, engine);
+#endif
+
         // Backend update
         // (stop updating them once we started aborting, as e.g. closed windows will have zero size etc.)
-        if (!aborted && !app_window->NewFrame(app_window))
+        if (!aborted && (g_App.Quit || !app_window->NewFrame(app_window)))
             aborted = true;
 
         // Abort logic
@@ -584,53 +747,1270 @@ int main(int argc, char** argv)
             break;
 
         ImGui::NewFrame();
-        ShowUI();
+        ShowUI(engine);
 
+        // In command-line mode, skip rendering when the test engine doesn't need draw data
+        const bool render = g_App.OptGui || test_io.IsRequestingRender;
+        if (render)
+        {
 #if IMGUI_VERSION_NUM >= 18701
-        if (!test_io.ConfigMouseDrawCursor && !test_io.IsCapturing && ImGuiTestEngine_UseSimulatedInputs(engine))
-            ImGui::RenderMouseCursor(io.MousePos, 1.0f, ImGui::GetMouseCursor(), IM_COL32_WHITE, IM_COL32_BLACK, IM_COL32(0, 0, 0, 48));
-            //ImGui::RenderMouseCursor(io.MousePos, 1.2f, ImGui::GetMouseCursor(), IM_COL32(255, 255, 120, 255), IM_COL32(0, 0, 0, 255), IM_COL32(0, 0, 0, 60)); // Custom yellow cursor
+            if (!test_io.ConfigMouseDrawCursor && !test_io.IsCapturing && ImGuiTestEngine_UseSimulatedInputs(engine))
+                ImGui::RenderMouseCursor(io.MousePos, 1.0f, ImGui::GetMouseCursor(), IM_COL32_WHITE, IM_COL32_BLACK, IM_COL32(0, 0, 0, 48));
+                //ImGui::RenderMouseCursor(io.MousePos, 1.2f, ImGui::GetMouseCursor(), IM_COL32(255, 255, 120, 255), IM_COL32(0, 0, 0, 255), IM_COL32(0, 0, 0, 60)); // Custom yellow cursor
 #endif
+            ImGui::Render();
+        }
+        else
+        {
+            ImGui::EndFrame();
+        }
 
-        ImGui::Render();
-
-        if (!g_App.OptGui && !test_io.IsRunningTests)
+        if (!g_App.OptGui && !test_io.IsRunningTests && g_App.Server == NULL)
             break;
 
-        app_window->Vsync = test_io.IsRequestingMaxAppSpeed ? false : true;
-        app_window->ClearColor = g_App.ClearColor;
-        app_window->Render(app_window);
+        if (render)
+        {
+            app_window->Vsync = test_io.IsRequestingMaxAppSpeed ? false : true;
+            app_window->ClearColor = g_App.ClearColor;
+            app_window->Render(app_window);
+        }
 
         // Post-swap handler is REQUIRED in order to support screen capture
         ImGuiTestEngine_PostSwap(engine);
     }
+    return aborted;
+}
+
+//-------------------------------------------------------------------------
+// Parallel Jobs (-jobs N)
+//-------------------------------------------------------------------------
+// Queued tests are split between N jobs, each running on its own thread with its own Dear ImGui context, null backend and test engine.
+// This relies on GImGui being thread-local (see IMGUI_TESTS_THREAD_LOCAL_CONTEXT in imgui_tests_imconfig.h).
+// Tests which rely on state shared by all contexts stay on the first job:
+// - 'demo' tests and tests flagged with ImGuiTestFlags_RequireAppWindows: imgui_demo.cpp keeps its state in static variables,
+//   so "Dear ImGui Demo" is only shown by the first job.
+// - 'capture' tests: captures write to shared output files.
+// - Performance tests: kept together, but measurements are not comparable to a serial run as other jobs are sharing the CPU.
+//-------------------------------------------------------------------------
+
+struct TestAppJob
+{
+    int                     JobIndex = 0;
+    ImVector<int>           TestIndices;            // Indices in ImGuiTestEngine_GetTestList(), valid for all engines as RegisterTests() is deterministic
+    Str256                  ExportFilename;         // Results of each job are exported separately then merged
+    ImVector<char*>         FailedTests;            // [Output] Names of failed tests
+    int                     CountTested = 0;        // [Output]
+    int                     CountSuccess = 0;       // [Output]
+    bool                    Aborted = false;        // [Output]
+};
+
+static bool IsTestPinnedToFirstJob(ImGuiTest* test)
+{
+    if (test->Group == ImGuiTestGroup_Perfs || (test->Flags & ImGuiTestFlags_RequireAppWindows))
+        return true;
+    return strcmp(test->Category, "demo") == 0 || strcmp(test->Category, "capture") == 0;
+}
+
+// Thread function: same setup as main() in command-line mode
+static void RunJob(TestAppJob* job)
+{
+    g_AllowDemoWindow = (job->JobIndex == 0);
+    ImGuiContext* ui_ctx = CreateImGuiContext(NULL);    // No .ini file, as all jobs would be writing to the same one
+    ImGuiApp* app_window = CreateAppWindow(false);
+    ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+    InitTestEngineIO(engine, app_window);
+    if (!job->ExportFilename.empty())
+    {
+        ImGuiTestEngineIO& test_io = ImGuiTestEngine_GetIO(engine);
+        test_io.ExportResultsFilename = job->ExportFilename.c_str();
+        test_io.ExportResultsFormat = g_App.OptExportFormat;
+    }
+
+    app_window->InitCreateWindow(app_window, "Dear ImGui: Test Engine", ImVec2(1440, 900));
+    app_window->InitBackends(app_window);
+
+    RegisterTests(engine);
+    ImVector<ImGuiTest*> tests;
+    ImGuiTestEngine_GetTestList(engine, &tests);
+    for (int test_n : job->TestIndices)
+        ImGuiTestEngine_QueueTest(engine, tests[test_n], GetTestRunFlags());
+
+    ImGuiTestEngine_Start(engine, ui_ctx);
+    LoadFonts(app_window->DpiScale);
+    ImGui::GetStyle().ScaleAllSizes(app_window->DpiScale);
 
+    job->Aborted = RunMainLoop(engine, app_window, true);
     ImGuiTestEngine_Stop(engine);
 
-    // Print results (command-line mode)
-    ImGuiTestAppErrorCode error_code = ImGuiTestAppErrorCode_Success;
-    if (!aborted)
+    if (!job->Aborted)
     {
-        int count_tested = 0;
-        int count_success = 0;
-        ImGuiTestEngine_GetResult(engine, count_tested, count_success);
-        ImGuiTestEngine_PrintResultSummary(engine);
-        if (count_tested != count_success)
-            error_code = ImGuiTestAppErrorCode_TestFailed;
+        ImGuiTestEngine_GetResult(engine, job->CountTested, job->CountSuccess);
+        for (ImGuiTest* test : tests)
+            if (test->Status == ImGuiTestStatus_Error)
+                job->FailedTests.push_back(ImStrdup(test->Name));
     }
 
-    // Shutdown window
     app_window->ShutdownBackends(app_window);
     app_window->ShutdownCloseWindow(app_window);
-
-    // Shutdown
-    // IMPORTANT: we need to destroy the Dear ImGui context BEFORE the test engine context, so .ini data may be saved.
-#if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
-    ImPlot::DestroyContext();
-#endif
-    ImGui::DestroyContext();
-    ImGuiTestEngine_DestroyContext(g_App.TestEngine);
+    DestroyImGuiContext(ui_ctx);
+    ImGuiTestEngine_DestroyContext(engine);
     app_window->Destroy(app_window);
+}
+
+static ImGuiTestAppErrorCode RunJobs(int jobs_count)
+{
+    // Apply test filter using a throwaway engine, then distribute queued tests to the job with the fewest tests
+    ImGuiTestEngine* plan_engine = ImGuiTestEngine_CreateContext();
+    RegisterTests(plan_engine);
+    QueueTests(plan_engine);
+    ImVector<ImGuiTest*> tests;
+    ImGuiTestEngine_GetTestList(plan_engine, &tests);
+
+    ImVector<TestAppJob*> jobs;
+    for (int job_n = 0; job_n < jobs_count; job_n++)
+    {
+        TestAppJob* job = IM_NEW(TestAppJob)();
+        job->JobIndex = job_n;
+        if (!g_App.OptExportFilename.empty())
+            job->ExportFilename.setf("%s.job%d", g_App.OptExportFilename.c_str(), job_n);
+        jobs.push_back(job);
+    }
+    int queued_count = 0;
+    for (int test_n = 0; test_n < tests.Size; test_n++)
+    {
+        if (tests[test_n]->Status != ImGuiTestStatus_Queued)
+            continue;
+        TestAppJob* job = jobs[0];
+        if (!IsTestPinnedToFirstJob(tests[test_n]))
+            for (TestAppJob* other_job : jobs)
+                if (other_job->TestIndices.Size < job->TestIndices.Size)
+                    job = other_job;
+        job->TestIndices.push_back(test_n);
+        queued_count++;
+    }
+    ImGuiTestEngine_DestroyContext(plan_engine);
+    printf("Running %d tests in %d jobs.\n", queued_count, jobs_count);
+
+    // Run jobs
+    const ImU64 start_time = ImTimeGetInMicroseconds();
+    ImVector<std::thread*> threads;
+    for (TestAppJob* job : jobs)
+        threads.push_back(IM_NEW(std::thread)(RunJob, job));
+    for (std::thread* thread : threads)
+    {
+        thread->join();
+        IM_DELETE(thread);
+    }
+    const double duration_secs = (ImTimeGetInMicroseconds() - start_time) / 1000000.0;
+
+    // Merge results exported by each job
+    if (!g_App.OptExportFilename.empty())
+    {
+        ImVector<const char*> job_export_filenames;
+        for (TestAppJob* job : jobs)
+            job_export_filenames.push_back(job->ExportFilename.c_str());
+        ImGuiTestEngine_MergeJUnitXml(g_App.OptExportFilename.c_str(), job_export_filenames.Data, job_export_filenames.Size);
+        for (const char* job_export_filename : job_export_filenames)
+            remove(job_export_filename);
+    }
+
+    // Print results (same format as ImGuiTestEngine_PrintResultSummary())
+    int count_tested = 0;
+    int count_success = 0;
+    bool aborted = false;
+    for (TestAppJob* job : jobs)
+    {
+        count_tested += job->CountTested;
+        count_success += job->CountSuccess;
+        aborted |= job->Aborted;
+    }
+    if (count_success < count_tested)
+    {
+        printf("\nFailing tests:\n");
+        for (TestAppJob* job : jobs)
+            for (char* test_name : job->FailedTests)
+                printf("- %s\n", test_name);
+    }
+    ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, (count_success == count_tested) ? ImOsConsoleTextColor_BrightGreen : ImOsConsoleTextColor_BrightRed);
+    printf("\nTests Result: %s\n", (count_success == count_tested) ? "OK" : "Errors");
+    printf("(%d/%d tests passed)\n", count_success, count_tested);
+    ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_White);
+    printf("(%d jobs in %.2f secs)\n", jobs_count, duration_secs);
+
+    for (TestAppJob* job : jobs)
+    {
+        for (char* test_name : job->FailedTests)
+            IM_FREE(test_name);
+        IM_DELETE(job);
+    }
+
+    if (aborted || count_tested != count_success)
+        return ImGuiTestAppErrorCode_TestFailed;
+    return ImGuiTestAppErrorCode_Success;
+}
+
+//-------------------------------------------------------------------------
+// Worker Processes (-workers N)
+//-------------------------------------------------------------------------
+// The coordinator forks N long-lived worker processes, each with its own Dear ImGui context, null backend and test engine.
+// Tests are pulled from a shared queue: whenever a worker sends back the result of a test, it is sent the next queued test,
+// so workers which got short tests run more of them. Results are applied to the coordinator's engine (see ImGuiTestEngine_ReadTestResult()),
+// which prints a single summary and exports a single file.
+// Unlike '-jobs', each worker has its own copy of static state (e.g. imgui_demo.cpp) so no test needs to stay on a given worker,
+// and a crashing worker only fails the test it was running. Performance tests are measured while other workers are sharing the CPU.
+// Protocol over pipes, one line per request:
+// - coordinator -> worker: "run <test_name>" or "quit"
+// - worker -> coordinator: one result record per "run" request (see ImGuiTestEngine_WriteTestResult())
+//-------------------------------------------------------------------------
+
+#ifndef _WIN32
+
+struct TestAppWorker
+{
+    int                     Pid = -1;
+    int                     RequestFd = -1;         // Write end of requests pipe
+    int                     ResultFd = -1;          // Read end of results pipe, -1 once worker exited
+    ImGuiTest*              RunningTest = NULL;     // Test sent to worker and waiting for a result
+    ImU64                   RunningTestStartTime = 0;
+    ImGuiTextBuffer         ResultBuffer;           // Received data which doesn't make a full record yet
+};
+
+static bool WriteToFd(int fd, const char* data, int size)
+{
+    while (size > 0)
+    {
+        ssize_t written = write(fd, data, (size_t)size);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            return false;
+        data += written;
+        size -= (int)written;
+    }
+    return true;
+}
+
+// Worker process: run tests requested by coordinator until "quit" or end of file
+static int RunWorkerProcess(int request_fd, int result_fd)
+{
+    ImGuiContext* ui_ctx = CreateImGuiContext(NULL);    // No .ini file, as all workers would be writing to the same one
+    ImGuiApp* app_window = CreateAppWindow(false);
+    ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+    InitTestEngineIO(engine, app_window);
+
+    app_window->InitCreateWindow(app_window, "Dear ImGui: Test Engine", ImVec2(1440, 900));
+    app_window->InitBackends(app_window);
+
+    RegisterTests(engine);
+    ImVector<ImGuiTest*> tests;
+    ImGuiTestEngine_GetTestList(engine, &tests);
+
+    ImGuiTestEngine_Start(engine, ui_ctx);
+    ImGuiTestEngine_InstallDefaultCrashHandler();
+    LoadFonts(app_window->DpiScale);
+    ImGui::GetStyle().ScaleAllSizes(app_window->DpiScale);
+
+    FILE* requests = fdopen(request_fd, "r");
+    char request[256];
+    ImGuiTextBuffer result;
+    bool aborted = false;
+    while (!aborted && fgets(request, IM_ARRAYSIZE(request), requests) != NULL)
+    {
+        if (char* eol = strchr(request, '\n'))
+            *eol = 0;
+        if (strncmp(request, "run ", 4) != 0)
+            break;
+
+        // Coordinator registered the same tests
+        ImGuiTest* test = NULL;
+        for (ImGuiTest* registered_test : tests)
+            if (strcmp(registered_test->Name, request + 4) == 0)
+            {
+                test = registered_test;
+                break;
+            }
+
+        result.clear();
+        if (test != NULL)
+        {
+            ImGuiTestEngine_QueueTest(engine, test, GetTestRunFlags());
+            aborted = RunMainLoop(engine, app_window, true);
+            ImGuiTestEngine_WriteTestResult(test, &result);
+        }
+        else
+        {
+            // Reply with an error so the coordinator doesn't wait for a result (it would only happen if registration differed)
+            ImGuiTest unknown_test;
+            unknown_test.Name = request + 4;
+            unknown_test.Status = ImGuiTestStatus_Error;
+            unknown_test.TestLog.Buffer.append("Test not registered in worker process.\n");
+            unknown_test.TestLog.UpdateLineOffsets(&ImGuiTestEngine_GetIO(engine), ImGuiTestVerboseLevel_Error, unknown_test.TestLog.Buffer.begin());
+            ImGuiTestEngine_WriteTestResult(&unknown_test, &result);
+        }
+        if (!WriteToFd(result_fd, result.c_str(), result.size()))
+            break;
+    }
+    fclose(requests);
+    close(result_fd);
+
+    ImGuiTestEngine_Stop(engine);
+    app_window->ShutdownBackends(app_window);
+    app_window->ShutdownCloseWindow(app_window);
+    DestroyImGuiContext(ui_ctx);
+    ImGuiTestEngine_DestroyContext(engine);
+    app_window->Destroy(app_window);
+    return aborted ? 1 : 0;
+}
+
+// Mark a test as failed when no result could be received for it
+static void SetTestFailedWithoutResult(ImGuiTestEngine* engine, ImGuiTest* test, ImU64 start_time, const char* reason)
+{
+    fprintf(stderr, "Test '%s': %s\n", test->Name, reason);
+    test->Status = ImGuiTestStatus_Error;
+    test->StartTime = start_time;
+    test->EndTime = ImTimeGetInMicroseconds();
+    const int prev_size = test->TestLog.Buffer.size();
+    test->TestLog.Buffer.appendf("%s\n", reason);
+    test->TestLog.UpdateLineOffsets(&ImGuiTestEngine_GetIO(engine), ImGuiTestVerboseLevel_Error, test->TestLog.Buffer.begin() + prev_size);
+}
+
+static void SendNextTestToWorker(TestAppWorker* worker, ImVector<ImGuiTest*>* pending_tests)
+{
+    IM_ASSERT(worker->RunningTest == NULL);
+    if (pending_tests->empty())
+        return;
+    ImGuiTest* test = pending_tests->back();
+    Str256f request("run %s\n", test->Name);
+    if (!WriteToFd(worker->RequestFd, request.c_str(), request.length()))
+        return; // Worker exited: end of file will be read from its results pipe
+    pending_tests->pop_back();
+    worker->RunningTest = test;
+    worker->RunningTestStartTime = ImTimeGetInMicroseconds();
+}
+
+// Apply first complete record received in 'buf' and remove it from 'buf'. Return false if 'buf' doesn't hold a complete record yet.
+static bool ReadNextTestResult(ImGuiTestEngine* engine, ImGuiTextBuffer* buf, ImGuiTest** out_test)
+{
+    const char* record = buf->c_str();
+    const char* record_end = strstr(record, "\nend\n");
+    if (record_end == NULL)
+        return false;
+    record_end += 5;
+    *out_test = ImGuiTestEngine_ReadTestResult(engine, record, record_end);
+    buf->Buf.erase(buf->Buf.begin(), buf->Buf.begin() + (record_end - record));
+    return true;
+}
+
+// Apply all complete records received from a worker, sending it a new test after each of them
+static void ProcessWorkerResults(ImGuiTestEngine* engine, TestAppWorker* worker, ImVector<ImGuiTest*>* pending_tests)
+{
+    ImGuiTest* test = NULL;
+    while (ReadNextTestResult(engine, &worker->ResultBuffer, &test))
+    {
+        if (worker->RunningTest != NULL && test != worker->RunningTest)
+            SetTestFailedWithoutResult(engine, worker->RunningTest, worker->RunningTestStartTime, "Invalid result received from worker process.");
+        worker->RunningTest = NULL;
+        SendNextTestToWorker(worker, pending_tests);
+    }
+}
+
+// Time after which a worker is considered stuck on a test, and killed.
+// Workers' own watchdog (see ConfigWatchdogKillApp) should trigger well before, so this catches workers which stopped running their main loop (e.g. deadlock).
+static ImU64 CalcWorkerTestTimeout(const ImVector<ImGuiTest*>& tests)
+{
+    ImU64 longest_duration = 0;
+    for (ImGuiTest* test : tests)
+        if (test->EndTime > test->StartTime)
+            longest_duration = ImMax(longest_duration, test->EndTime - test->StartTime); // Durations imported with -shard-durations
+    return ImMax(longest_duration * 4, (ImU64)60 * 1000000);
+}
+
+static ImGuiTestAppErrorCode RunWorkers(int workers_count)
+{
+    // Apply test filter using our own engine, which also collects results from workers
+    ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+    ImGuiTestEngineIO& test_io = ImGuiTestEngine_GetIO(engine);
+    test_io.ConfigVerboseLevel = g_App.OptVerboseLevelBasic;    // Log lines written by exporters
+    test_io.ConfigVerboseLevelOnError = g_App.OptVerboseLevelError;
+    RegisterTests(engine);
+    QueueTests(engine);
+    ImVector<ImGuiTest*> tests;
+    ImGuiTestEngine_GetTestList(engine, &tests);
+    ImVector<ImGuiTest*> pending_tests;                         // In reverse order, next test is at the back
+    for (int test_n = tests.Size - 1; test_n >= 0; test_n--)
+        if (tests[test_n]->Status == ImGuiTestStatus_Queued)
+            pending_tests.push_back(tests[test_n]);
+    const ImU64 test_timeout = CalcWorkerTestTimeout(pending_tests);
+    printf("Running %d tests in %d worker processes.\n", pending_tests.Size, workers_count);
+
+    // Fork workers
+    // (writing to a pipe of an exited process fails with EPIPE instead of killing us with SIGPIPE)
+    const ImU64 start_time = ImTimeGetInMicroseconds();
+    signal(SIGPIPE, SIG_IGN);
+    fflush(stdout);
+    fflush(stderr);
+    ImVector<TestAppWorker*> workers;
+    for (int worker_n = 0; worker_n < workers_count; worker_n++)
+    {
+        int request_pipe[2];
+        int result_pipe[2];
+        if (pipe(request_pipe) != 0)
+            break;
+        if (pipe(result_pipe) != 0)
+        {
+            close(request_pipe[0]);
+            close(request_pipe[1]);
+            break;
+        }
+        const pid_t pid = fork();
+        if (pid == 0)
+        {
+            close(request_pipe[1]);
+            close(result_pipe[0]);
+            for (TestAppWorker* other_worker : workers)
+            {
+                close(other_worker->RequestFd);
+                close(other_worker->ResultFd);
+            }
+            exit(RunWorkerProcess(request_pipe[0], result_pipe[1]));
+        }
+        close(request_pipe[0]);
+        close(result_pipe[1]);
+        if (pid < 0)
+        {
+            close(request_pipe[1]);
+            close(result_pipe[0]);
+            break;
+        }
+        TestAppWorker* worker = IM_NEW(TestAppWorker)();
+        worker->Pid = pid;
+        worker->RequestFd = request_pipe[1];
+        worker->ResultFd = result_pipe[0];
+        workers.push_back(worker);
+    }
+    if (workers.Size < workers_count)
+        fprintf(stderr, "Could only start %d worker processes out of %d: %s\n", workers.Size, workers_count, strerror(errno));
+
+    // Dispatch tests until all results are received or all workers exited
+    for (TestAppWorker* worker : workers)
+        SendNextTestToWorker(worker, &pending_tests);
+    ImVector<pollfd> poll_fds;
+    ImVector<TestAppWorker*> poll_workers;
+    while (true)
+    {
+        poll_fds.resize(0);
+        poll_workers.resize(0);
+        for (TestAppWorker* worker : workers)
+            if (worker->ResultFd != -1)
+            {
+                pollfd poll_fd = { worker->ResultFd, POLLIN, 0 };
+                poll_fds.push_back(poll_fd);
+                poll_workers.push_back(worker);
+            }
+        bool any_running = false;
+        ImU64 next_deadline = ~(ImU64)0;
+        for (TestAppWorker* worker : poll_workers)
+            if (worker->RunningTest != NULL)
+            {
+                any_running = true;
+                next_deadline = ImMin(next_deadline, worker->RunningTestStartTime + test_timeout);
+            }
+        if (!any_running && (pending_tests.empty() || poll_workers.empty()))
+            break;
+
+        // Kill workers stuck on a test: their results pipe will then reach end of file
+        const ImU64 now = ImTimeGetInMicroseconds();
+        if (now >= next_deadline)
+        {
+            for (TestAppWorker* worker : poll_workers)
+                if (worker->RunningTest != NULL && now >= worker->RunningTestStartTime + test_timeout)
+                {
+                    kill(worker->Pid, SIGKILL);
+                    SetTestFailedWithoutResult(engine, worker->RunningTest, worker->RunningTestStartTime, Str128f("Worker process %d killed after running test for %.0f secs.", (int)worker->Pid, test_timeout / 1000000.0).c_str());
+                    worker->RunningTest = NULL;
+                }
+            continue;
+        }
+
+        const int timeout_ms = (int)((next_deadline - now + 999) / 1000);
+        if (poll(poll_fds.Data, (nfds_t)poll_fds.Size, any_running ? timeout_ms : -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            perror("poll");
+            break;
+        }
+        for (int n = 0; n < poll_fds.Size; n++)
+        {
+            if ((poll_fds[n].revents & (POLLIN | POLLHUP | POLLERR)) == 0)
+                continue;
+            TestAppWorker* worker = poll_workers[n];
+            char buf[4096];
+            const ssize_t read_size = read(worker->ResultFd, buf, sizeof(buf));
+            if (read_size < 0 && errno == EINTR)
+                continue;
+            if (read_size > 0)
+            {
+                worker->ResultBuffer.append(buf, buf + read_size);
+                ProcessWorkerResults(engine, worker, &pending_tests);
+                continue;
+            }
+
+            // End of file: worker exited (e.g. crashed), other workers take its remaining share of tests
+            close(worker->ResultFd);
+            worker->ResultFd = -1;
+            if (worker->RunningTest != NULL)
+                SetTestFailedWithoutResult(engine, worker->RunningTest, worker->RunningTestStartTime, Str64f("Worker process %d exited while running test.", (int)worker->Pid).c_str());
+            worker->RunningTest = NULL;
+        }
+    }
+    for (ImGuiTest* test : pending_tests)
+        SetTestFailedWithoutResult(engine, test, 0, "No worker process left to run test.");
+    for (TestAppWorker* worker : workers)
+        if (worker->RunningTest != NULL)
+            SetTestFailedWithoutResult(engine, worker->RunningTest, worker->RunningTestStartTime, "Worker process stopped responding.");
+
+    // Stop workers
+    bool aborted = false;
+    for (TestAppWorker* worker : workers)
+    {
+        WriteToFd(worker->RequestFd, "quit\n", 5);
+        close(worker->RequestFd);
+    }
+    for (TestAppWorker* worker : workers)
+    {
+        int status = 0;
+        waitpid(worker->Pid, &status, 0);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            aborted = true;
+        if (worker->ResultFd != -1)
+            close(worker->ResultFd);
+        IM_DELETE(worker);
+    }
+    const double duration_secs = (ImTimeGetInMicroseconds() - start_time) / 1000000.0;
+
+    // Print and export results of all workers
+    int count_tested = 0;
+    int count_success = 0;
+    ImGuiTestEngine_GetResult(engine, count_tested, count_success);
+    ImGuiTestEngine_PrintResultSummary(engine);
+    printf("(%d worker processes in %.2f secs)\n", workers.Size, duration_secs);
+    if (!g_App.OptExportFilename.empty())
+        ImGuiTestEngine_ExportEx(engine, g_App.OptExportFormat, g_App.OptExportFilename.c_str());
+    if (!g_App.OptResultCacheFilename.empty())
+        ImGuiTestEngine_SaveResultCache(engine, g_App.OptResultCacheFilename.c_str());
+    ImGuiTestEngine_DestroyContext(engine);
+
+    if (aborted || count_tested != count_success)
+        return ImGuiTestAppErrorCode_TestFailed;
+    return ImGuiTestAppErrorCode_Success;
+}
+
+//-------------------------------------------------------------------------
+// Crash Isolation (-isolate N)
+//-------------------------------------------------------------------------
+// Context, backend, fonts and tests are set up once, then each batch of N tests runs in a forked child of this warmed-up process.
+// Results are sent back through a pipe after each test (see ImGuiTestEngine_WriteTestResult()). When a child crashes, the parent
+// marks the test which didn't send a result as failed, and runs remaining tests of the batch in a new child.
+// ImGuiTestEngine_Start() is called by each child, as the coroutine may run on a thread, which wouldn't survive fork().
+//-------------------------------------------------------------------------
+
+// Child process: run tests of batch, sending result of each test as soon as it is done
+static int RunIsolatedBatch(ImGuiTestEngine* engine, ImGuiContext* ui_ctx, ImGuiApp* app_window, const ImVector<ImGuiTest*>& batch, int result_fd)
+{
+    ImGuiTestEngine_Start(engine, ui_ctx);
+    ImGuiTestEngine_InstallDefaultCrashHandler();
+
+    ImGuiTextBuffer result;
+    for (ImGuiTest* test : batch)
+    {
+        ImGuiTestEngine_QueueTest(engine, test, GetTestRunFlags());
+        const bool aborted = RunMainLoop(engine, app_window, true);
+        result.clear();
+        ImGuiTestEngine_WriteTestResult(test, &result);
+        if (!WriteToFd(result_fd, result.c_str(), result.size()) || aborted)
+            return 1;
+    }
+    return 0;
+}
+
+static ImGuiTestAppErrorCode RunIsolated(int batch_size)
+{
+    // Apply test filter using a throwaway engine, so our engine has no queued test that children would run
+    ImGuiTestEngine* plan_engine = ImGuiTestEngine_CreateContext();
+    RegisterTests(plan_engine);
+    QueueTests(plan_engine);
+    ImVector<ImGuiTest*> plan_tests;
+    ImGuiTestEngine_GetTestList(plan_engine, &plan_tests);
+    ImVector<int> queued_test_indices;
+    for (int test_n = 0; test_n < plan_tests.Size; test_n++)
+        if (plan_tests[test_n]->Status == ImGuiTestStatus_Queued)
+            queued_test_indices.push_back(test_n);
+    ImGuiTestEngine_DestroyContext(plan_engine);
+
+    // Warm up: same setup as main() in command-line mode, minus ImGuiTestEngine_Start()
+    ImGuiContext* ui_ctx = CreateImGuiContext(NULL);    // No .ini file, as children would be writing to the same one
+    ImGuiApp* app_window = CreateAppWindow(false);
+    ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+    InitTestEngineIO(engine, app_window);
+    app_window->InitCreateWindow(app_window, "Dear ImGui: Test Engine", ImVec2(1440, 900));
+    app_window->InitBackends(app_window);
+    RegisterTests(engine);
+    LoadFonts(app_window->DpiScale);
+    ImGui::GetStyle().ScaleAllSizes(app_window->DpiScale);
+
+    ImVector<ImGuiTest*> tests;
+    ImGuiTestEngine_GetTestList(engine, &tests);
+    ImVector<ImGuiTest*> pending_tests;                         // In reverse order, next test is at the back
+    for (int n = queued_test_indices.Size - 1; n >= 0; n--)
+        pending_tests.push_back(tests[queued_test_indices[n]]);
+    printf("Running %d tests in batches of %d, each in a forked process.\n", pending_tests.Size, batch_size);
+
+    const ImU64 start_time = ImTimeGetInMicroseconds();
+    int children_count = 0;
+    int crash_count = 0;
+    ImVector<ImGuiTest*> batch;
+    ImGuiTextBuffer result_buffer;
+    while (!pending_tests.empty())
+    {
+        batch.resize(0);
+        while (!pending_tests.empty() && batch.Size < batch_size)
+        {
+            batch.push_back(pending_tests.back());
+            pending_tests.pop_back();
+        }
+
+        int result_pipe[2];
+        if (pipe(result_pipe) != 0)
+        {
+            perror("pipe");
+            break;
+        }
+        fflush(stdout);
+        fflush(stderr);
+        const ImU64 batch_start_time = ImTimeGetInMicroseconds();
+        const pid_t pid = fork();
+        if (pid == 0)
+        {
+            // Child process is discarded: skip shutdown, only flush log output
+            close(result_pipe[0]);
+            const int exit_code = RunIsolatedBatch(engine, ui_ctx, app_window, batch, result_pipe[1]);
+            fflush(stdout);
+            fflush(stderr);
+            _exit(exit_code);
+        }
+        close(result_pipe[1]);
+        if (pid < 0)
+        {
+            perror("fork");
+            close(result_pipe[0]);
+            break;
+        }
+        children_count++;
+
+        // Receive results until child exits
+        result_buffer.clear();
+        char buf[4096];
+        ssize_t read_size;
+        while ((read_size = read(result_pipe[0], buf, sizeof(buf))) != 0)
+        {
+            if (read_size > 0)
+                result_buffer.append(buf, buf + read_size);
+            else if (errno != EINTR)
+                break;
+        }
+        close(result_pipe[0]);
+        int status = 0;
+        while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+
+        // Results are received in order of batch
+        ImGuiTest* test = NULL;
+        int batch_n = 0;
+        while (ReadNextTestResult(engine, &result_buffer, &test))
+            if (batch_n < batch.Size && test == batch[batch_n])
+                batch_n++;
+
+        // First test without a result crashed: record it and give remaining tests of batch to next child
+        if (batch_n < batch.Size)
+        {
+            Str128f reason("Process crashed while running test (%s).", WIFSIGNALED(status) ? strsignal(WTERMSIG(status)) : Str16f("exit code %d", WEXITSTATUS(status)).c_str());
+            SetTestFailedWithoutResult(engine, batch[batch_n], (batch_n > 0) ? batch[batch_n - 1]->EndTime : batch_start_time, reason.c_str());
+            crash_count++;
+            for (int n = batch.Size - 1; n > batch_n; n--)
+                pending_tests.push_back(batch[n]);
+        }
+    }
+    for (ImGuiTest* test : pending_tests)
+        SetTestFailedWithoutResult(engine, test, 0, "Test was not run.");
+    const double duration_secs = (ImTimeGetInMicroseconds() - start_time) / 1000000.0;
+
+    // Print and export results of all children
+    int count_tested = 0;
+    int count_success = 0;
+    ImGuiTestEngine_GetResult(engine, count_tested, count_success);
+    ImGuiTestEngine_PrintResultSummary(engine);
+    printf("(%d processes in %.2f secs, %d crashed)\n", children_count, duration_secs, crash_count);
+    if (!g_App.OptExportFilename.empty())
+        ImGuiTestEngine_ExportEx(engine, g_App.OptExportFormat, g_App.OptExportFilename.c_str());
+    if (!g_App.OptResultCacheFilename.empty())
+        ImGuiTestEngine_SaveResultCache(engine, g_App.OptResultCacheFilename.c_str());
+
+    app_window->ShutdownBackends(app_window);
+    app_window->ShutdownCloseWindow(app_window);
+    DestroyImGuiContext(ui_ctx);
+    ImGuiTestEngine_DestroyContext(engine);
+    app_window->Destroy(app_window);
+
+    if (count_tested != count_success)
+        return ImGuiTestAppErrorCode_TestFailed;
+    return ImGuiTestAppErrorCode_Success;
+}
+
+//-------------------------------------------------------------------------
+// Test Server (-server <socket_path>)
+//-------------------------------------------------------------------------
+// The application stays alive after setup and accepts commands on a local socket, so e.g. an editor integration may run tests
+// without paying for startup (font atlas, registration) on each run. Commands and replies are text lines:
+// - "queue <filter>": queue tests like ImGuiTestEngine_QueueTests() (filter syntax of command-line). Reply "queued <count>".
+// - "results": wait until the test queue is empty, then reply "results <tested> <success>", followed by one record per test
+//   queued by this client since its last "results" command (see ImGuiTestEngine_WriteTestResult()), followed by "done".
+// - "quit": reply "bye" and exit application.
+// Example: printf "queue widgets_button\nresults\n" | nc -U -q 60 imgui_tests.sock
+//-------------------------------------------------------------------------
+
+// Replies are queued and written without blocking, so a client which doesn't read them can't stall tests.
+// A client with more than this amount of unread replies is dropped.
+static const int SERVER_CLIENT_MAX_PENDING_OUTPUT = 64 * 1024 * 1024;
+
+struct TestAppServerClient
+{
+    int                     Fd = -1;                // Non-blocking
+    ImGuiTextBuffer         RecvBuffer;             // Received data which doesn't make a full line yet
+    ImGuiTextBuffer         SendBuffer;             // Replies not written yet
+    ImVector<ImGuiTest*>    QueuedTests;            // Tests queued by this client, reported by next "results" command
+    bool                    WaitingResults = false; // Received "results", reply once test queue is empty
+    bool                    Disconnected = false;   // Read or write failed, or too many unread replies: removed by UpdateServer()
+};
+
+struct TestAppServer
+{
+    Str128                          SocketPath;
+    int                             ListenFd = -1;
+    ImVector<TestAppServerClient*>  Clients;
+};
+
+static TestAppServer* CreateServer(const char* socket_path)
+{
+    sockaddr_un addr = {};
+    addr.sun_family = AF_UNIX;
+    if (strlen(socket_path) >= sizeof(addr.sun_path))
+    {
+        fprintf(stderr, "Server socket path '%s' is too long.\n", socket_path);
+        return NULL;
+    }
+    strcpy(addr.sun_path, socket_path);
+
+    const int listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0)
+    {
+        perror("socket");
+        return NULL;
+    }
+
+    // Remove socket left over by a previous server which didn't exit cleanly, but never anything else
+    struct stat st;
+    if (lstat(socket_path, &st) == 0)
+    {
+        if (!S_ISSOCK(st.st_mode))
+        {
+            fprintf(stderr, "Server socket path '%s' already exists and is not a socket.\n", socket_path);
+            close(listen_fd);
+            return NULL;
+        }
+        unlink(socket_path);
+    }
+    if (bind(listen_fd, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listen_fd, 4) != 0)
+    {
+        fprintf(stderr, "Listening on '%s' failed: %s\n", socket_path, strerror(errno));
+        close(listen_fd);
+        return NULL;
+    }
+
+    // Disconnected clients make writes fail with EPIPE instead of killing us with SIGPIPE
+    // (call after ImGuiTestEngine_InstallDefaultCrashHandler(), which also handles SIGPIPE)
+    signal(SIGPIPE, SIG_IGN);
+
+    TestAppServer* server = IM_NEW(TestAppServer)();
+    server->SocketPath = socket_path;
+    server->ListenFd = listen_fd;
+    printf("Listening for commands on '%s'.\n", socket_path);
+    return server;
+}
+
+// Write as much of queued replies as possible without blocking
+static void FlushServerClient(TestAppServerClient* client)
+{
+    while (!client->Disconnected && client->SendBuffer.size() > 0)
+    {
+        const ssize_t written = write(client->Fd, client->SendBuffer.c_str(), (size_t)client->SendBuffer.size());
+        if (written > 0)
+            client->SendBuffer.Buf.erase(client->SendBuffer.Buf.begin(), client->SendBuffer.Buf.begin() + written);
+        else if (written < 0 && errno == EINTR)
+            continue;
+        else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            break;
+        else
+            client->Disconnected = true;
+    }
+    if (!client->Disconnected && client->SendBuffer.size() > SERVER_CLIENT_MAX_PENDING_OUTPUT)
+    {
+        fprintf(stderr, "Server client is not reading replies, disconnecting it.\n");
+        client->Disconnected = true;
+    }
+}
+
+static void SendToServerClient(TestAppServerClient* client, const char* data, int size)
+{
+    if (client->Disconnected)
+        return;
+    client->SendBuffer.append(data, data + size);
+    FlushServerClient(client);
+}
+
+static void DestroyServer(TestAppServer* server)
+{
+    for (TestAppServerClient* client : server->Clients)
+    {
+        FlushServerClient(client); // Best effort (e.g. reply to "quit")
+        close(client->Fd);
+        IM_DELETE(client);
+    }
+    close(server->ListenFd);
+    unlink(server->SocketPath.c_str());
+    IM_DELETE(server);
+}
+
+static void ProcessServerCommand(ImGuiTestEngine* engine, TestAppServerClient* client, const char* command)
+{
+    if (strncmp(command, "queue ", 6) == 0)
+    {
+        // Remember which tests were queued by this command, to report their results
+        ImVector<ImGuiTest*> tests;
+        ImGuiTestEngine_GetTestList(engine, &tests);
+        ImVector<bool> was_queued;
+        for (ImGuiTest* test : tests)
+            was_queued.push_back(test->Status == ImGuiTestStatus_Queued);
+        ImGuiTestEngine_QueueTests(engine, ImGuiTestGroup_Unknown, command + 6, GetTestRunFlags());
+        int queued_count = 0;
+        for (int test_n = 0; test_n < tests.Size; test_n++)
+            if (!was_queued[test_n] && tests[test_n]->Status == ImGuiTestStatus_Queued)
+            {
+                if (!client->QueuedTests.contains(tests[test_n]))
+                    client->QueuedTests.push_back(tests[test_n]);
+                queued_count++;
+            }
+        Str64f reply("queued %d\n", queued_count);
+        SendToServerClient(client, reply.c_str(), reply.length());
+    }
+    else if (strcmp(command, "results") == 0)
+    {
+        client->WaitingResults = true;
+    }
+    else if (strcmp(command, "quit") == 0)
+    {
+        SendToServerClient(client, "bye\n", 4);
+        g_App.Quit = true;
+    }
+    else
+    {
+        Str256f reply("error unknown command '%s'\n", command);
+        SendToServerClient(client, reply.c_str(), reply.length());
+    }
+}
+
+// Process received lines. Commands following "results" wait for its reply, so replies are in order of commands.
+static void ProcessServerCommands(ImGuiTestEngine* engine, TestAppServerClient* client)
+{
+    while (!client->WaitingResults)
+    {
+        const char* eol = strchr(client->RecvBuffer.c_str(), '\n');
+        if (eol == NULL)
+            break;
+        Str256 command;
+        command.set(client->RecvBuffer.c_str(), (eol > client->RecvBuffer.c_str() && eol[-1] == '\r') ? eol - 1 : eol);
+        client->RecvBuffer.Buf.erase(client->RecvBuffer.Buf.begin(), client->RecvBuffer.Buf.begin() + (eol + 1 - client->RecvBuffer.c_str()));
+        ProcessServerCommand(engine, client, command.c_str());
+    }
+}
+
+static void SendServerResults(TestAppServerClient* client)
+{
+    int count_tested = 0;
+    int count_success = 0;
+    for (ImGuiTest* test : client->QueuedTests)
+    {
+        if (test->Status == ImGuiTestStatus_Unknown)
+            continue;
+        count_tested++;
+        if (test->Status == ImGuiTestStatus_Success)
+            count_success++;
+    }
+    ImGuiTextBuffer reply;
+    reply.appendf("results %d %d\n", count_tested, count_success);
+    for (ImGuiTest* test : client->QueuedTests)
+        ImGuiTestEngine_WriteTestResult(test, &reply);
+    reply.append("done\n");
+    SendToServerClient(client, reply.c_str(), reply.size());
+    client->QueuedTests.clear();
+    client->WaitingResults = false;
+}
+
+static void RemoveDisconnectedServerClients(TestAppServer* server)
+{
+    for (int client_n = server->Clients.Size - 1; client_n >= 0; client_n--)
+    {
+        TestAppServerClient* client = server->Clients[client_n];
+        if (!client->Disconnected)
+            continue;
+        close(client->Fd);
+        IM_DELETE(client);
+        server->Clients.erase(server->Clients.Data + client_n);
+    }
+}
+
+// Called by RunMainLoop() once per frame. In command-line mode, block until a command is received when there is nothing to run.
+static void UpdateServer(TestAppServer* server, ImGuiTestEngine* engine)
+{
+    ImGuiTestEngineIO& test_io = ImGuiTestEngine_GetIO(engine);
+    const bool is_idle = ImGuiTestEngine_IsTestQueueEmpty(engine) && !test_io.IsRunningTests;
+    if (is_idle)
+        for (TestAppServerClient* client : server->Clients)
+            if (client->WaitingResults)
+            {
+                SendServerResults(client);
+                ProcessServerCommands(engine, client);
+            }
+    RemoveDisconnectedServerClients(server);
+
+    ImVector<pollfd> poll_fds;
+    pollfd listen_poll_fd = { server->ListenFd, POLLIN, 0 };
+    poll_fds.push_back(listen_poll_fd);
+    for (TestAppServerClient* client : server->Clients)
+    {
+        pollfd client_poll_fd = { client->Fd, (short)(POLLIN | (client->SendBuffer.size() > 0 ? POLLOUT : 0)), 0 };
+        poll_fds.push_back(client_poll_fd);
+    }
+    const bool wait_for_command = is_idle && ImGuiTestEngine_IsTestQueueEmpty(engine) && !g_App.Quit && !g_App.OptGui; // (commands buffered above may have queued tests or quit)
+    if (poll(poll_fds.Data, (nfds_t)poll_fds.Size, wait_for_command ? -1 : 0) > 0)
+    {
+        // Write pending replies, read commands
+        for (int client_n = 0; client_n < server->Clients.Size; client_n++)
+        {
+            TestAppServerClient* client = server->Clients[client_n];
+            const short revents = poll_fds[client_n + 1].revents;
+            if (revents & POLLOUT)
+                FlushServerClient(client);
+            if ((revents & (POLLIN | POLLHUP | POLLERR)) == 0 || client->Disconnected)
+                continue;
+            char buf[1024];
+            const ssize_t read_size = read(client->Fd, buf, sizeof(buf));
+            if (read_size > 0)
+            {
+                client->RecvBuffer.append(buf, buf + read_size);
+                ProcessServerCommands(engine, client);
+            }
+            else if (read_size == 0 || (errno != EINTR && errno != EAGAIN && errno != EWOULDBLOCK))
+            {
+                client->Disconnected = true;
+            }
+        }
+
+        // Accept new client
+        if (poll_fds[0].revents & POLLIN)
+        {
+            const int client_fd = accept(server->ListenFd, NULL, NULL);
+            if (client_fd >= 0)
+            {
+                fcntl(client_fd, F_SETFL, fcntl(client_fd, F_GETFL) | O_NONBLOCK);
+                TestAppServerClient* client = IM_NEW(TestAppServerClient)();
+                client->Fd = client_fd;
+                server->Clients.push_back(client);
+            }
+        }
+    }
+    RemoveDisconnectedServerClients(server);
+}
+
+#endif // #ifndef _WIN32
+
+int main(int argc, char** argv)
+{
+#ifdef DEBUG_CRT
+    DebugCrtInit(0);
+#endif
+
+    // Parse command-line arguments
+#if defined(IMGUI_APP_WIN32_DX11) || defined(IMGUI_APP_SDL_GL2) || defined(IMGUI_APP_SDL_GL3) || defined(IMGUI_APP_GLFW_GL3)
+    g_App.OptGui = true;
+#endif
+
+#ifdef CMDLINE_ARGS
+    if (argc == 1)
+    {
+        printf("# [exe] %s\n", CMDLINE_ARGS);
+        ImParseExtractArgcArgvFromCommandLine(&argc, (const char***)&argv, CMDLINE_ARGS);
+        if (!ParseCommandLineOptions(argc, argv))
+            return ImGuiTestAppErrorCode_CommandLineError;
+        free(argv);
+    }
+    else
+#endif
+    {
+        if (!ParseCommandLineOptions(argc, argv))
+            return ImGuiTestAppErrorCode_CommandLineError;
+    }
+    argv = NULL;
+
+    // Merge results of shards, e.g. '-merge-junit output/tests.junit.xml output/tests.shard1.junit.xml output/tests.shard2.junit.xml'
+    if (!g_App.OptMergeJUnitFilename.empty())
+    {
+        const bool ret = ImGuiTestEngine_MergeJUnitXml(g_App.OptMergeJUnitFilename.c_str(), g_App.TestsToRun.Data, g_App.TestsToRun.Size);
+        for (char* filename : g_App.TestsToRun)
+            IM_FREE(filename);
+        g_App.TestsToRun.clear();
+        return ret ? ImGuiTestAppErrorCode_Success : ImGuiTestAppErrorCode_CommandLineError;
+    }
+
+    // Default verbose levels differs whether we are in in GUI or Command-Line mode
+    if (g_App.OptGui)
+    {
+        // Default -v4 -ve4
+        if (g_App.OptVerboseLevelBasic == ImGuiTestVerboseLevel_COUNT)
+            g_App.OptVerboseLevelBasic = ImGuiTestVerboseLevel_Debug;
+        if (g_App.OptVerboseLevelError == ImGuiTestVerboseLevel_COUNT)
+            g_App.OptVerboseLevelError = ImGuiTestVerboseLevel_Debug;
+    }
+    else
+    {
+        // Default -v2 -ve4
+        if (g_App.OptVerboseLevelBasic == ImGuiTestVerboseLevel_COUNT)
+            g_App.OptVerboseLevelBasic = ImGuiTestVerboseLevel_Warning;
+        if (g_App.OptVerboseLevelError == ImGuiTestVerboseLevel_COUNT)
+            g_App.OptVerboseLevelError = ImGuiTestVerboseLevel_Debug;
+    }
+
+    // Parallel jobs are only supported in command-line mode
+    if (g_App.OptJobs > 1)
+    {
+#if IMGUI_TESTS_THREAD_LOCAL_CONTEXT
+        const bool jobs_supported = true;
+#else
+        const bool jobs_supported = false;
+#endif
+        if (g_App.OptGui || !jobs_supported)
+        {
+            fprintf(stderr, "-jobs requires -nogui and a build with IMGUI_TESTS_THREAD_LOCAL_CONTEXT=1, ignoring.\n");
+            g_App.OptJobs = 1;
+        }
+    }
+
+    // Worker processes are only supported in command-line mode
+    if (g_App.OptWorkers > 0)
+    {
+#ifdef _WIN32
+        const bool workers_supported = false;
+#else
+        const bool workers_supported = true;
+#endif
+        if (g_App.OptGui || !workers_supported)
+        {
+            fprintf(stderr, "-workers requires -nogui and a POSIX platform, ignoring.\n");
+            g_App.OptWorkers = 0;
+        }
+        else if (g_App.OptJobs > 1)
+        {
+            fprintf(stderr, "-jobs is ignored when using -workers.\n");
+            g_App.OptJobs = 1;
+        }
+    }
+
+    // Crash isolation is only supported in command-line mode
+    if (g_App.OptIsolate > 0)
+    {
+#ifdef _WIN32
+        const bool isolate_supported = false;
+#else
+        const bool isolate_supported = true;
+#endif
+        if (g_App.OptGui || !isolate_supported || g_App.OptJobs > 1 || g_App.OptWorkers > 0)
+        {
+            fprintf(stderr, "-isolate requires -nogui and a POSIX platform, and can't be used with -jobs or -workers, ignoring.\n");
+            g_App.OptIsolate = 0;
+        }
+    }
+
+    // Result cache is only updated by the main process and worker/isolation modes, which collect results of all tests
+    if (g_App.OptChangedOnly && g_App.OptResultCacheFilename.empty())
+        g_App.OptResultCacheFilename = "imgui_tests.cache";
+    if (!g_App.OptResultCacheFilename.empty() && g_App.OptJobs > 1)
+        fprintf(stderr, "-result-cache is not updated when using -jobs, use -workers instead.\n");
+    g_App.BuildId = g_App.OptBuildId.c_str();
+    if (!g_App.OptResultCacheFilename.empty() && g_App.BuildId.empty() && !CalcSourcesBuildId(&g_App.BuildId))
+    {
+        if (g_App.OptChangedOnly)
+            fprintf(stderr, "-changed-only requires -build-id as dear imgui sources could not be read, ignoring.\n");
+        g_App.OptChangedOnly = false;
+    }
+
+    // Server mode is only supported on POSIX platforms, and runs tests in the main process
+    if (!g_App.OptServerSocketPath.empty())
+    {
+#ifdef _WIN32
+        fprintf(stderr, "-server requires a POSIX platform, ignoring.\n");
+        g_App.OptServerSocketPath.clear();
+#else
+        if (g_App.OptJobs > 1 || g_App.OptWorkers > 0 || g_App.OptIsolate > 0)
+            fprintf(stderr, "-jobs, -workers and -isolate are ignored when using -server.\n");
+        g_App.OptJobs = 1;
+        g_App.OptWorkers = g_App.OptIsolate = 0;
+        g_App.OptPauseOnExit = false;
+#endif
+    }
+
+    // Custom allocator functions, only to test overriding of allocators.
+    ImGui::SetAllocatorFunctions(&MallocWrapper, &FreeWrapper, &g_App);
+    ImGuiMemAllocFunc alloc_func;
+    ImGuiMemFreeFunc free_func;
+    void* alloc_user_data;
+    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &alloc_user_data);
+    IM_ASSERT(alloc_func == &MallocWrapper);
+    IM_ASSERT(free_func == &FreeWrapper);
+    IM_ASSERT(alloc_user_data == &g_App);
+
+    // Retrieve Git branch name, store in annotation field by default
+    Str64 git_repo_path;
+    if (ImFileFindInParents("imgui/", 4, &git_repo_path))
+        ImBuildGetGitBranchName(git_repo_path.c_str(), &g_App.GitBranchName);
+    if (g_App.GitBranchName.empty())
+    {
+        g_App.GitBranchName.set("unknown");
+        fprintf(stderr, "Dear ImGui git repository was not found.\n");
+    }
+    printf("Git branch: \"%s\"\n", g_App.GitBranchName.c_str());
+
+    // Setup Dear ImGui binding
+    IMGUI_CHECKVERSION();
+    ImGuiTestAppErrorCode error_code = ImGuiTestAppErrorCode_Success;
+    if (g_App.OptJobs > 1)
+    {
+        ImGuiTestEngine_InstallDefaultCrashHandler();
+        error_code = RunJobs(g_App.OptJobs);
+    }
+#ifndef _WIN32
+    else if (g_App.OptWorkers > 0)
+    {
+        error_code = RunWorkers(g_App.OptWorkers);
+    }
+    else if (g_App.OptIsolate > 0)
+    {
+        error_code = RunIsolated(g_App.OptIsolate);
+    }
+#endif
+    else
+    {
+        ImGuiContext* ui_ctx = CreateImGuiContext("imgui.ini");
+
+        // Creates window
+        g_App.AppWindow = CreateAppWindow(g_App.OptGui);
+
+        // Create TestEngine context
+        IM_ASSERT(g_App.TestEngine == NULL);
+        ImGuiTestEngine* engine = ImGuiTestEngine_CreateContext();
+        g_App.TestEngine = engine;
+
+        // Apply options
+        InitTestEngineIO(engine, g_App.AppWindow);
+
+        // Enable test result export
+        ImGuiTestEngineIO& test_io = ImGuiTestEngine_GetIO(engine);
+        if (!g_App.OptExportFilename.empty())
+        {
+            if (!g_App.TestsToRun.empty() || !g_App.OptGui)
+            {
+                test_io.ExportResultsFilename = g_App.OptExportFilename.c_str();
+                test_io.ExportResultsFormat = !g_App.OptExportFilename.empty() ? g_App.OptExportFormat : ImGuiTestEngineExportFormat_None;
+            }
+            else
+            {
+                fprintf(stderr, "-junit-xml parameter is ignored in interactive runs.");
+            }
+        }
+
+        // Create window
+        ImGuiApp* app_window = g_App.AppWindow;
+        app_window->InitCreateWindow(app_window, "Dear ImGui: Test Engine", ImVec2(1440, 900));
+        app_window->InitBackends(app_window);
+
+        // Register and queue our tests
+        // (server mode doesn't queue all tests by default, only those given on command-line)
+        RegisterTests(engine);
+        if (g_App.OptServerSocketPath.empty() || !g_App.TestsToRun.empty())
+            QueueTests(engine);
+        bool exit_after_tests = !ImGuiTestEngine_IsTestQueueEmpty(engine) && !g_App.OptPauseOnExit && g_App.OptServerSocketPath.empty();
+
+        // Start engine
+        ImGuiTestEngine_Start(engine, ui_ctx);
+        ImGuiTestEngine_InstallDefaultCrashHandler();
+
+        // Load fonts, Set DPI scale
+        LoadFonts(app_window->DpiScale);
+        ImGui::GetStyle().ScaleAllSizes(app_window->DpiScale);
+        //test_io.DpiScale = app_window->DpiScale;
+
+#ifndef _WIN32
+        // Start server (after ImGuiTestEngine_InstallDefaultCrashHandler(), see CreateServer())
+        if (!g_App.OptServerSocketPath.empty())
+        {
+            g_App.Server = CreateServer(g_App.OptServerSocketPath.c_str());
+            if (g_App.Server == NULL)
+                g_App.Quit = true;
+        }
+#endif
+
+        // Main loop
+        bool aborted = RunMainLoop(engine, app_window, exit_after_tests);
+
+        ImGuiTestEngine_Stop(engine);
+#ifndef _WIN32
+        if (g_App.Server != NULL)
+        {
+            DestroyServer(g_App.Server);
+            g_App.Server = NULL;
+        }
+#endif
+
+        // Print results (command-line mode)
+        if (!aborted)
+        {
+            int count_tested = 0;
+            int count_success = 0;
+            ImGuiTestEngine_GetResult(engine, count_tested, count_success);
+            ImGuiTestEngine_PrintResultSummary(engine);
+            if (!g_App.OptResultCacheFilename.empty())
+                ImGuiTestEngine_SaveResultCache(engine, g_App.OptResultCacheFilename.c_str());
+            if (count_tested != count_success)
+                error_code = ImGuiTestAppErrorCode_TestFailed;
+        }
+
+        // Shutdown window
+        app_window->ShutdownBackends(app_window);
+        app_window->ShutdownCloseWindow(app_window);
+
+        // Shutdown
+        DestroyImGuiContext(ui_ctx);
+        ImGuiTestEngine_DestroyContext(g_App.TestEngine);
+        app_window->Destroy(app_window);
+    }
 
     if (g_App.OptPauseOnExit && !g_App.OptGui)
     {
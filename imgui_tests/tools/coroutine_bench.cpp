@@ -0,0 +1,268 @@
+// dear imgui test engine - Standalone benchmark of coroutine implementations (ImGuiTestCoroutineInterface)
+// Drives Create/Run/Yield/Destroy of every compiled-in implementation in a tight loop, without a dear imgui context.
+// Use the results to pick ImGuiTestEngineIO::CoroutineFuncs for your platform.
+
+// Usage, e.g.
+//   make coroutine_bench && ./coroutine_bench
+//   ./coroutine_bench -n 1000000 -impl ucontext
+
+// Reports, for each implementation:
+// - Create+Destroy cost (includes the first Run() which typically spawns the thread or touches the stack).
+// - Latency distribution of each switch: 'resume' = caller calls Run() -> coroutine returns from Yield(), 'yield' = coroutine calls Yield() -> caller returns from Run().
+// - Wall time, CPU time (user+system, all threads) and context switches (voluntary/involuntary) during the switch loop.
+
+#ifdef _MSC_VER
+#pragma warning (disable: 4996)     // 'This function or variable may be unsafe': strcpy, strdup, sprintf, vsnprintf, sscanf, fopen
+#endif
+
+#include "imgui.h"
+#include "imgui_internal.h"     // ImMin(), ImMax(), ImQsort()
+#include "imgui_test_engine/imgui_te_coroutine.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>           // steady_clock::now()
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>        // GetProcessTimes()
+#else
+#include <sys/resource.h>   // getrusage()
+#endif
+
+// Storage for current context pointer made thread-local by imgui_tests_imconfig.h (defined in main.cpp for imgui_tests)
+#if IMGUI_TESTS_THREAD_LOCAL_CONTEXT
+thread_local ImGuiContext* GImGuiThreadLocal = NULL;
+#endif
+
+//-------------------------------------------------------------------------
+// Helpers
+//-------------------------------------------------------------------------
+
+static ImU64 GetTimeInNanoseconds()
+{
+    return (ImU64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Process-wide resource usage (summed over all threads)
+struct BenchUsage
+{
+    ImU64   CpuUserUs = 0;
+    ImU64   CpuSystemUs = 0;
+    ImS64   VoluntaryCtxSwitches = -1;      // -1 when not available on this platform
+    ImS64   InvoluntaryCtxSwitches = -1;
+};
+
+static BenchUsage GetUsage()
+{
+    BenchUsage usage;
+#ifdef _WIN32
+    FILETIME creation_time, exit_time, kernel_time, user_time;
+    if (GetProcessTimes(GetCurrentProcess(), &creation_time, &exit_time, &kernel_time, &user_time))
+    {
+        usage.CpuUserUs = (((ImU64)user_time.dwHighDateTime << 32) | user_time.dwLowDateTime) / 10;
+        usage.CpuSystemUs = (((ImU64)kernel_time.dwHighDateTime << 32) | kernel_time.dwLowDateTime) / 10;
+    }
+#else
+    struct rusage ru;
+    if (getrusage(RUSAGE_SELF, &ru) == 0)
+    {
+        usage.CpuUserUs = (ImU64)ru.ru_utime.tv_sec * 1000000 + (ImU64)ru.ru_utime.tv_usec;
+        usage.CpuSystemUs = (ImU64)ru.ru_stime.tv_sec * 1000000 + (ImU64)ru.ru_stime.tv_usec;
+        usage.VoluntaryCtxSwitches = ru.ru_nvcsw;
+        usage.InvoluntaryCtxSwitches = ru.ru_nivcsw;
+    }
+#endif
+    return usage;
+}
+
+static int IMGUI_CDECL CompareU32(const void* lhs, const void* rhs)
+{
+    const ImU32 a = *(const ImU32*)lhs;
+    const ImU32 b = *(const ImU32*)rhs;
+    return (a < b) ? -1 : (a > b) ? +1 : 0;
+}
+
+// Sort samples and print min/percentiles/max
+static void PrintDistribution(const char* label, ImVector<ImU32>& samples)
+{
+    if (samples.Size == 0)
+        return;
+    ImQsort(samples.Data, (size_t)samples.Size, sizeof(ImU32), CompareU32);
+    const int n = samples.Size;
+    printf("  %-16s min %6u  p50 %6u  p90 %6u  p99 %6u  p99.9 %7u  max %8u ns\n", label,
+        samples[0], samples[n * 50 / 100], samples[n * 90 / 100], samples[n * 99 / 100], samples[(int)((ImS64)n * 999 / 1000)], samples[n - 1]);
+}
+
+//-------------------------------------------------------------------------
+// Benchmark
+//-------------------------------------------------------------------------
+
+struct BenchState
+{
+    ImGuiTestCoroutineInterface*    Funcs = NULL;
+    int                             YieldCount = 0;         // Number of times the coroutine yields before terminating
+    bool                            Record = false;         // Record timestamps (disabled while measuring Create/Destroy)
+    ImU64                           YieldStartTime = 0;     // Written by the coroutine just before calling Yield()
+    ImU64                           ResumeEndTime = 0;      // Written by the coroutine just after returning from Yield()
+};
+
+static void BenchCoroutineMain(void* data)
+{
+    BenchState& state = *(BenchState*)data;
+    for (int n = 0; n < state.YieldCount; n++)
+    {
+        if (state.Record)
+            state.YieldStartTime = GetTimeInNanoseconds();
+        state.Funcs->YieldFunc();
+        if (state.Record)
+            state.ResumeEndTime = GetTimeInNanoseconds();
+    }
+}
+
+static void Bench(const char* name, ImGuiTestCoroutineInterface* funcs, int round_trips, int create_count)
+{
+    printf("%s:\n", name);
+    BenchState state;
+    state.Funcs = funcs;
+
+    // Create+Destroy (coroutine terminates on its first Run())
+    {
+        state.YieldCount = 0;
+        state.Record = false;
+        const ImU64 start_time = GetTimeInNanoseconds();
+        for (int n = 0; n < create_count; n++)
+        {
+            ImGuiTestCoroutineHandle handle = funcs->CreateFunc(BenchCoroutineMain, "Bench Coroutine", &state);
+            while (funcs->RunFunc(handle)) {}
+            funcs->DestroyFunc(handle);
+        }
+        const ImU64 duration = GetTimeInNanoseconds() - start_time;
+        printf("  %-16s %.2f us avg (%d iterations)\n", "create+destroy", duration / 1000.0 / create_count, create_count);
+    }
+
+    // Switch loop
+    ImVector<ImU32> resume_latencies;
+    ImVector<ImU32> yield_latencies;
+    resume_latencies.reserve(round_trips);
+    yield_latencies.reserve(round_trips);
+
+    state.YieldCount = round_trips;
+    state.Record = true;
+    ImGuiTestCoroutineHandle handle = funcs->CreateFunc(BenchCoroutineMain, "Bench Coroutine", &state);
+    funcs->RunFunc(handle); // Warm up: first Run() starts the coroutine, which then yields a first time
+
+    const BenchUsage usage_start = GetUsage();
+    const ImU64 start_time = GetTimeInNanoseconds();
+    while (true)
+    {
+        const ImU64 resume_start_time = GetTimeInNanoseconds();
+        const bool running = funcs->RunFunc(handle);
+        const ImU64 yield_end_time = GetTimeInNanoseconds();
+        if (!running)
+            break;
+        resume_latencies.push_back((ImU32)ImMin(state.ResumeEndTime - resume_start_time, (ImU64)UINT_MAX));
+        yield_latencies.push_back((ImU32)ImMin(yield_end_time - state.YieldStartTime, (ImU64)UINT_MAX));
+    }
+    const ImU64 duration = GetTimeInNanoseconds() - start_time;
+    const BenchUsage usage_end = GetUsage();
+    funcs->DestroyFunc(handle);
+
+    const int switch_count = (resume_latencies.Size + yield_latencies.Size);
+    const double wall_ms = duration / 1000000.0;
+    const double cpu_user_ms = (usage_end.CpuUserUs - usage_start.CpuUserUs) / 1000.0;
+    const double cpu_system_ms = (usage_end.CpuSystemUs - usage_start.CpuSystemUs) / 1000.0;
+    printf("  %-16s %d switches in %.1f ms wall (%.0f switches/sec)\n", "throughput", switch_count, wall_ms, switch_count / (wall_ms / 1000.0));
+    printf("  %-16s %.1f ms user, %.1f ms system (%.0f%% of wall)\n", "cpu", cpu_user_ms, cpu_system_ms, wall_ms > 0.0 ? (cpu_user_ms + cpu_system_ms) * 100.0 / wall_ms : 0.0);
+    if (usage_start.VoluntaryCtxSwitches >= 0)
+    {
+        const ImS64 voluntary = usage_end.VoluntaryCtxSwitches - usage_start.VoluntaryCtxSwitches;
+        const ImS64 involuntary = usage_end.InvoluntaryCtxSwitches - usage_start.InvoluntaryCtxSwitches;
+        printf("  %-16s %lld voluntary, %lld involuntary (%.3f per switch)\n", "context switches", (long long)voluntary, (long long)involuntary, switch_count ? (double)(voluntary + involuntary) / switch_count : 0.0);
+    }
+    else
+    {
+        printf("  %-16s n/a\n", "context switches");
+    }
+    PrintDistribution("resume latency", resume_latencies);
+    PrintDistribution("yield latency", yield_latencies);
+}
+
+//-------------------------------------------------------------------------
+// Main
+//-------------------------------------------------------------------------
+
+struct BenchImpl
+{
+    const char*                     Name;
+    ImGuiTestCoroutineInterface*    Funcs;
+};
+
+int main(int argc, char** argv)
+{
+    int round_trips = 200000;
+    int create_count = 200;
+    const char* impl_filter = NULL;
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "-n") == 0 && n + 1 < argc)
+        {
+            round_trips = atoi(argv[n + 1]);
+            n++;
+        }
+        else if (strcmp(argv[n], "-create") == 0 && n + 1 < argc)
+        {
+            create_count = atoi(argv[n + 1]);
+            n++;
+        }
+        else if (strcmp(argv[n], "-impl") == 0 && n + 1 < argc)
+        {
+            impl_filter = argv[n + 1];
+            n++;
+        }
+        else
+        {
+            printf("Syntax: %s <options>\n", argv[0]);
+            printf("Options:\n");
+            printf("  -h                       : show command-line help.\n");
+            printf("  -n <int>                 : number of Run()/Yield() round-trips per implementation (default: 200000).\n");
+            printf("  -create <int>            : number of Create()/Destroy() iterations per implementation (default: 200).\n");
+            printf("  -impl <impl>             : only benchmark given implementation: stdthread, stdthread-futex, ucontext (when compiled in).\n");
+            return 0;
+        }
+    }
+    round_trips = ImMax(round_trips, 1);
+    create_count = ImMax(create_count, 1);
+
+    ImVector<BenchImpl> impls;
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_STDTHREAD_IMPL
+    impls.push_back({ "stdthread", Coroutine_ImplStdThread_GetInterface() });
+#if defined(__linux__)
+    impls.push_back({ "stdthread-futex", Coroutine_ImplStdThreadFutex_GetInterface() });
+#endif
+#endif
+#if IMGUI_TEST_ENGINE_ENABLE_COROUTINE_UCONTEXT_IMPL
+    impls.push_back({ "ucontext", Coroutine_ImplUcontext_GetInterface() });
+#endif
+    if (impls.Size == 0)
+    {
+        fprintf(stderr, "No coroutine implementation compiled in (see IMGUI_TEST_ENGINE_ENABLE_COROUTINE_XXX_IMPL in imgui_te_imconfig.h).\n");
+        return 1;
+    }
+
+    int bench_count = 0;
+    for (BenchImpl& impl : impls)
+    {
+        if (impl_filter != NULL && strcmp(impl_filter, impl.Name) != 0)
+            continue;
+        Bench(impl.Name, impl.Funcs, round_trips, create_count);
+        bench_count++;
+    }
+    if (bench_count == 0)
+    {
+        fprintf(stderr, "Unknown or disabled coroutine implementation '%s'.\n", impl_filter);
+        return 1;
+    }
+    return 0;
+}
@@ -157,6 +157,13 @@ static bool ImGuiApp_ImplNull_NewFrame(ImGuiApp* app_opaque)
     //int height = 0;
     //io.Fonts->GetTexDataAsAlpha8(&pixels, &width, &height);
 
+    // Fixed time step: don't read the clock at all, so frames are identical from run to run and the loop is as fast as the CPU allows
+    if (app->FixedDeltaTime > 0.0f)
+    {
+        io.DeltaTime = app->FixedDeltaTime;
+        return true;
+    }
+
     uint64_t time = ImGuiApp_GetTimeInMicroseconds();
     if (app->LastTime == 0)
         app->LastTime = time;
@@ -28,6 +28,7 @@ struct ImGuiApp
     bool    MockViewports = false;                      // [In]  InitBackends()
     float   DpiScale = 1.0f;                            // [Out] InitCreateWindow() / NewFrame()
     bool    Vsync = true;                               // [Out] Render()
+    float   FixedDeltaTime = 0.0f;                      // [In]  NewFrame(): when > 0.0f, use this delta time instead of reading the clock (only honored by Null backend, for deterministic headless runs)
 
     bool    (*InitCreateWindow)(ImGuiApp* app, const char* window_title, ImVec2 window_size) = nullptr;
     void    (*InitBackends)(ImGuiApp* app) = nullptr;